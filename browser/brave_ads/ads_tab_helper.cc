@@ -28,6 +28,18 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Conversions only look for the verifiable conversion id meta element, so
+// serialize that instead of the whole document, which can be megabytes of
+// markup on large pages
+const char kConversionHtmlScript[] = R"(
+    Array.from(document.querySelectorAll('meta[name="ad-conversion-id"]'))
+        .map((element) => new XMLSerializer().serializeToString(element))
+        .join('\n'))";
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(sessions::SessionTabHelper::IdForTab(web_contents)),
@@ -79,7 +91,7 @@ void AdsTabHelper::RunIsolatedJavaScript(
   DCHECK(render_frame_host);
 
   dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "new XMLSerializer().serializeToString(document)",
+      render_frame_host, kConversionHtmlScript,
       base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
                      weak_factory_.GetWeakPtr()));
 
@@ -76,3 +76,10 @@ void BraveBrowserMainExtraParts::PreMainMessageLoopRun() {
   brave::BraveUptimeTracker::CreateInstance(g_browser_process->local_state());
 #endif  // !defined(OS_ANDROID)
 }
+
+void BraveBrowserMainExtraParts::PostMainMessageLoopRun() {
+#if BUILDFLAG(BRAVE_P3A_ENABLED)
+  // Runs before local state is committed for the last time.
+  g_brave_browser_process->brave_p3a_service()->Shutdown();
+#endif  // BUILDFLAG(BRAVE_P3A_ENABLED)
+}
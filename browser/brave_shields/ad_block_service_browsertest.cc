@@ -13,6 +13,7 @@
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
+#include "brave/common/extensions/api/brave_shields.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
@@ -33,6 +34,8 @@
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/event_router.h"
+#include "extensions/browser/test_event_router_observer.h"
 #include "extensions/test/extension_test_message_listener.h"
 #include "net/dns/mock_host_resolver.h"
 
@@ -76,6 +79,29 @@ const char kTrackingProtectionComponentTest64PublicKey[] =
 using brave_shields::features::kBraveAdblockCosmeticFiltering;
 using content::BrowserThread;
 
+namespace {
+
+// Counts the brave_shields OnBlocked events broadcast for a profile
+class BlockedEventCounter : public extensions::TestEventRouterObserver {
+ public:
+  explicit BlockedEventCounter(extensions::EventRouter* event_router)
+      : extensions::TestEventRouterObserver(event_router) {}
+
+  int count() const { return count_; }
+
+ private:
+  void OnWillDispatchEvent(const extensions::Event& event) override {
+    if (event.event_name ==
+        extensions::api::brave_shields::OnBlocked::kEventName) {
+      count_++;
+    }
+  }
+
+  int count_ = 0;
+};
+
+}  // namespace
+
 void AdBlockServiceTest::SetUpOnMainThread() {
   ExtensionBrowserTest::SetUpOnMainThread();
   host_resolver()->AddRule("*", "127.0.0.1");
@@ -475,6 +501,38 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, TwoDiffAdsGetCountedAsTwo) {
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 2ULL);
 }
 
+// Load the same adblocked xhr request several times, it should only broadcast
+// one blocked event per page.
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, SameAdDispatchesOneEventPerPage) {
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+
+  GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
+  ui_test_utils::NavigateToURL(browser(), url);
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+
+  BlockedEventCounter blocked_events(
+      extensions::EventRouter::Get(browser()->profile()));
+  ASSERT_EQ(true, EvalJs(contents,
+                         "setExpectations(0, 0, 0, 1);"
+                         "xhr('adbanner.js')"));
+  ASSERT_EQ(true, EvalJs(contents,
+                         "setExpectations(0, 0, 0, 2);"
+                         "xhr('adbanner.js')"));
+  ASSERT_EQ(true, EvalJs(contents,
+                         "setExpectations(0, 0, 0, 3);"
+                         "xhr('adbanner.js')"));
+  EXPECT_EQ(blocked_events.count(), 1);
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+
+  ui_test_utils::NavigateToURL(browser(), url);
+  ASSERT_EQ(true, EvalJs(contents,
+                         "setExpectations(0, 0, 0, 1);"
+                         "xhr('adbanner.js')"));
+  EXPECT_EQ(blocked_events.count(), 2);
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 2ULL);
+}
+
 // New tab continues to count blocking the same resource
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, NewTabContinuesToBlock) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
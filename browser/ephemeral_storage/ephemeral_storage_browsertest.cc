@@ -6,6 +6,7 @@
 #include <string>
 
 #include "base/path_service.h"
+#include "base/strings/string_number_conversions.h"
 #include "brave/common/brave_paths.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -21,6 +22,7 @@
 #include "content/public/browser/storage_partition.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
 #include "content/public/test/test_navigation_observer.h"
 #include "net/base/features.h"
 #include "net/dns/mock_host_resolver.h"
@@ -338,6 +340,47 @@ IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
   EXPECT_EQ("", values_after.iframe_2.cookies);
 }
 
+IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
+                       StorageIsCreatedForLateThirdPartyFrames) {
+  // The page has no third-party frames when it commits, so its ephemeral
+  // storage is only set up once the first of the frames below commits.
+  ui_test_utils::NavigateToURL(browser(),
+                               https_server_.GetURL("a.com", "/simple.html"));
+  auto* web_contents = browser()->tab_strip_model()->GetActiveWebContents();
+
+  const int kFrameCount = 10;
+  const GURL b_site_url = https_server_.GetURL("b.com", "/simple.html");
+  for (int i = 0; i < kFrameCount; ++i) {
+    const std::string id = "frame" + base::NumberToString(i);
+    ASSERT_TRUE(content::ExecJs(
+        web_contents,
+        content::JsReplace("const frame = document.createElement('iframe');"
+                           "frame.id = $1;"
+                           "document.body.appendChild(frame);",
+                           id)));
+    ASSERT_TRUE(NavigateIframeToURL(web_contents, id, b_site_url));
+  }
+
+  RenderFrameHost* main_frame = web_contents->GetMainFrame();
+  SetValuesInFrame(content::ChildFrameAt(main_frame, 0), "b.com - third party",
+                   "from=b.com");
+  for (int i = 0; i < kFrameCount; ++i) {
+    ValuesFromFrame values =
+        GetValuesFromFrame(content::ChildFrameAt(main_frame, i));
+    EXPECT_EQ("b.com - third party", values.local_storage);
+    EXPECT_EQ("b.com - third party", values.session_storage);
+    EXPECT_EQ("from=b.com", values.cookies);
+  }
+
+  // None of it is visible to b.com as a first party.
+  WebContents* site_b_tab = LoadURLInNewTab(b_site_url);
+  ValuesFromFrame first_party_values =
+      GetValuesFromFrame(site_b_tab->GetMainFrame());
+  EXPECT_EQ(nullptr, first_party_values.local_storage);
+  EXPECT_EQ(nullptr, first_party_values.session_storage);
+  EXPECT_EQ("", first_party_values.cookies);
+}
+
 IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
                        ReloadDoesNotClearEphemeralStorage) {
   ui_test_utils::NavigateToURL(browser(), a_site_ephemeral_storage_url_);
@@ -533,3 +576,64 @@ IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
   EXPECT_EQ("third-party-a.com", third_party_values.session_storage);
   EXPECT_EQ("name=third-party-a.com", third_party_values.cookies);
 }
+
+class EphemeralStorageKeepAliveBrowserTest
+    : public EphemeralStorageBrowserTest {
+ public:
+  EphemeralStorageKeepAliveBrowserTest() {
+    keep_alive_feature_list_.InitAndEnableFeature(
+        net::features::kBraveEphemeralStorageKeepAlive);
+  }
+
+ private:
+  base::test::ScopedFeatureList keep_alive_feature_list_;
+};
+
+IN_PROC_BROWSER_TEST_F(EphemeralStorageKeepAliveBrowserTest,
+                       ReopeningSiteReusesEphemeralStorage) {
+  WebContents* site_a_tab = LoadURLInNewTab(a_site_ephemeral_storage_url_);
+  SetValuesInFrames(site_a_tab, "a.com value", "from=a.com");
+
+  int tab_index =
+      browser()->tab_strip_model()->GetIndexOfWebContents(site_a_tab);
+  bool was_closed = browser()->tab_strip_model()->CloseWebContentsAt(
+      tab_index, TabStripModel::CloseTypes::CLOSE_NONE);
+  EXPECT_TRUE(was_closed);
+
+  // The ephemeral storage of the closed tab is still kept alive, so the
+  // third-party iframes get it back. Session storage belonged to that tab.
+  ui_test_utils::NavigateToURL(browser(), a_site_ephemeral_storage_url_);
+  auto* web_contents = browser()->tab_strip_model()->GetActiveWebContents();
+
+  ValuesFromFrames values_after = GetValuesFromFrames(web_contents);
+  EXPECT_EQ("a.com value", values_after.iframe_1.local_storage);
+  EXPECT_EQ("a.com value", values_after.iframe_2.local_storage);
+
+  EXPECT_EQ(nullptr, values_after.iframe_1.session_storage);
+  EXPECT_EQ(nullptr, values_after.iframe_2.session_storage);
+
+  EXPECT_EQ("from=a.com", values_after.iframe_1.cookies);
+  EXPECT_EQ("from=a.com", values_after.iframe_2.cookies);
+}
+
+IN_PROC_BROWSER_TEST_F(EphemeralStorageKeepAliveBrowserTest,
+                       ClosingPrivateWindowReleasesKeptAliveStorage) {
+  Browser* private_browser = CreateIncognitoBrowser(nullptr);
+  ui_test_utils::NavigateToURL(private_browser, a_site_ephemeral_storage_url_);
+  SetValuesInFrames(private_browser->tab_strip_model()->GetActiveWebContents(),
+                    "a.com value", "from=a.com");
+
+  // Closing the window destroys the off the record profile while its storage
+  // is still kept alive, which has to be released along with the profile.
+  CloseBrowserSynchronously(private_browser);
+
+  Browser* new_private_browser = CreateIncognitoBrowser(nullptr);
+  ui_test_utils::NavigateToURL(new_private_browser,
+                               a_site_ephemeral_storage_url_);
+  ValuesFromFrames values = GetValuesFromFrames(
+      new_private_browser->tab_strip_model()->GetActiveWebContents());
+  EXPECT_EQ(nullptr, values.iframe_1.local_storage);
+  EXPECT_EQ(nullptr, values.iframe_2.local_storage);
+  EXPECT_EQ("", values.iframe_1.cookies);
+  EXPECT_EQ("", values.iframe_2.cookies);
+}
@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/ephemeral_storage/ephemeral_storage_service.h"
+
+#include <utility>
+
+#include "content/public/browser/session_storage_namespace.h"
+#include "content/public/browser/tld_ephemeral_lifetime.h"
+
+namespace ephemeral_storage {
+
+EphemeralStorageService::Entry::Entry(
+    base::TimeTicks expiry,
+    scoped_refptr<content::TLDEphemeralLifetime> tld_ephemeral_lifetime,
+    scoped_refptr<content::SessionStorageNamespace> local_storage_namespace)
+    : expiry(expiry),
+      tld_ephemeral_lifetime(std::move(tld_ephemeral_lifetime)),
+      local_storage_namespace(std::move(local_storage_namespace)) {}
+
+EphemeralStorageService::Entry::Entry(Entry&&) = default;
+
+EphemeralStorageService::Entry& EphemeralStorageService::Entry::operator=(
+    Entry&&) = default;
+
+EphemeralStorageService::Entry::~Entry() = default;
+
+EphemeralStorageService::EphemeralStorageService() = default;
+
+EphemeralStorageService::~EphemeralStorageService() = default;
+
+void EphemeralStorageService::KeepAlive(
+    scoped_refptr<content::TLDEphemeralLifetime> tld_ephemeral_lifetime,
+    scoped_refptr<content::SessionStorageNamespace> local_storage_namespace,
+    base::TimeDelta delay) {
+  if (is_shutdown_)
+    return;
+
+  entries_.emplace_back(base::TimeTicks::Now() + delay,
+                        std::move(tld_ephemeral_lifetime),
+                        std::move(local_storage_namespace));
+  if (!timer_.IsRunning()) {
+    timer_.Start(FROM_HERE, delay, this,
+                 &EphemeralStorageService::ReleaseExpired);
+  }
+}
+
+void EphemeralStorageService::Shutdown() {
+  is_shutdown_ = true;
+  timer_.Stop();
+  entries_.clear();
+}
+
+void EphemeralStorageService::ReleaseExpired() {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  while (!entries_.empty() && entries_.front().expiry <= now)
+    entries_.pop_front();
+
+  if (!entries_.empty()) {
+    timer_.Start(FROM_HERE, entries_.front().expiry - now, this,
+                 &EphemeralStorageService::ReleaseExpired);
+  }
+}
+
+}  // namespace ephemeral_storage
@@ -0,0 +1,73 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_EPHEMERAL_STORAGE_EPHEMERAL_STORAGE_SERVICE_H_
+#define BRAVE_BROWSER_EPHEMERAL_STORAGE_EPHEMERAL_STORAGE_SERVICE_H_
+
+#include "base/containers/circular_deque.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "components/keyed_service/core/keyed_service.h"
+
+namespace content {
+class SessionStorageNamespace;
+class TLDEphemeralLifetime;
+}  // namespace content
+
+namespace ephemeral_storage {
+
+// Holds on to the ephemeral storage of a domain after a tab stopped using it,
+// so that it survives redirects which end up back at the original domain and
+// is reused when the domain is reopened shortly after. Everything which
+// expired is released by a single timer, rather than a task per navigation.
+// There is one instance per BrowserContext, including off the record ones, so
+// that storage which is still held is released on Shutdown, while the storage
+// partitions it refers to are alive.
+class EphemeralStorageService : public KeyedService {
+ public:
+  EphemeralStorageService();
+  ~EphemeralStorageService() override;
+
+  EphemeralStorageService(const EphemeralStorageService&) = delete;
+  EphemeralStorageService& operator=(const EphemeralStorageService&) = delete;
+
+  // Keeps |tld_ephemeral_lifetime| and |local_storage_namespace| alive for
+  // |delay|. Does nothing once the service is shut down.
+  void KeepAlive(
+      scoped_refptr<content::TLDEphemeralLifetime> tld_ephemeral_lifetime,
+      scoped_refptr<content::SessionStorageNamespace> local_storage_namespace,
+      base::TimeDelta delay);
+
+  // KeyedService:
+  void Shutdown() override;
+
+ private:
+  struct Entry {
+    Entry(base::TimeTicks expiry,
+          scoped_refptr<content::TLDEphemeralLifetime> tld_ephemeral_lifetime,
+          scoped_refptr<content::SessionStorageNamespace>
+              local_storage_namespace);
+    Entry(Entry&&);
+    Entry& operator=(Entry&&);
+    ~Entry();
+
+    base::TimeTicks expiry;
+    scoped_refptr<content::TLDEphemeralLifetime> tld_ephemeral_lifetime;
+    scoped_refptr<content::SessionStorageNamespace> local_storage_namespace;
+  };
+
+  void ReleaseExpired();
+
+  bool is_shutdown_ = false;
+  // Ordered by expiry. Entries are pushed with the same delay outside of
+  // tests, so ReleaseExpired stops at the first entry that is still alive.
+  base::circular_deque<Entry> entries_;
+  base::OneShotTimer timer_;
+};
+
+}  // namespace ephemeral_storage
+
+#endif  // BRAVE_BROWSER_EPHEMERAL_STORAGE_EPHEMERAL_STORAGE_SERVICE_H_
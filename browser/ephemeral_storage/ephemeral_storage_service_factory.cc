@@ -0,0 +1,44 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/ephemeral_storage/ephemeral_storage_service_factory.h"
+
+#include "brave/browser/ephemeral_storage/ephemeral_storage_service.h"
+#include "chrome/browser/profiles/incognito_helpers.h"
+#include "components/keyed_service/content/browser_context_dependency_manager.h"
+
+namespace ephemeral_storage {
+
+// static
+EphemeralStorageService* EphemeralStorageServiceFactory::GetForBrowserContext(
+    content::BrowserContext* context) {
+  return static_cast<EphemeralStorageService*>(
+      GetInstance()->GetServiceForBrowserContext(context,
+                                                 /*create_service=*/true));
+}
+
+// static
+EphemeralStorageServiceFactory* EphemeralStorageServiceFactory::GetInstance() {
+  return base::Singleton<EphemeralStorageServiceFactory>::get();
+}
+
+EphemeralStorageServiceFactory::EphemeralStorageServiceFactory()
+    : BrowserContextKeyedServiceFactory(
+          "EphemeralStorageService",
+          BrowserContextDependencyManager::GetInstance()) {}
+
+EphemeralStorageServiceFactory::~EphemeralStorageServiceFactory() {}
+
+content::BrowserContext* EphemeralStorageServiceFactory::GetBrowserContextToUse(
+    content::BrowserContext* context) const {
+  return chrome::GetBrowserContextOwnInstanceInIncognito(context);
+}
+
+KeyedService* EphemeralStorageServiceFactory::BuildServiceInstanceFor(
+    content::BrowserContext* context) const {
+  return new EphemeralStorageService();
+}
+
+}  // namespace ephemeral_storage
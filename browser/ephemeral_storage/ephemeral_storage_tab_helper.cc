@@ -7,12 +7,13 @@
 
 #include <map>
 #include <set>
+#include <utility>
 
 #include "base/feature_list.h"
 #include "base/hash/md5.h"
-#include "base/no_destructor.h"
 #include "base/optional.h"
-#include "base/threading/sequenced_task_runner_handle.h"
+#include "brave/browser/ephemeral_storage/ephemeral_storage_service.h"
+#include "brave/browser/ephemeral_storage/ephemeral_storage_service_factory.h"
 #include "content/public/browser/navigation_handle.h"
 #include "content/public/browser/session_storage_namespace.h"
 #include "content/public/browser/storage_partition.h"
@@ -56,7 +57,8 @@ std::string StringToSessionStorageId(const std::string& string,
 // design document at:
 // https://github.com/brave/brave-browser/wiki/Ephemeral-Storage-Design
 EphemeralStorageTabHelper::EphemeralStorageTabHelper(WebContents* web_contents)
-    : WebContentsObserver(web_contents) {
+    : WebContentsObserver(web_contents),
+      browser_context_(web_contents->GetBrowserContext()) {
   DCHECK(base::FeatureList::IsEnabled(net::features::kBraveEphemeralStorage));
 
   // The URL might not be empty if this is a restored WebContents, for instance.
@@ -66,12 +68,16 @@ EphemeralStorageTabHelper::EphemeralStorageTabHelper(WebContents* web_contents)
       net::URLToEphemeralStorageDomain(url), url);
 }
 
-EphemeralStorageTabHelper::~EphemeralStorageTabHelper() {}
+EphemeralStorageTabHelper::~EphemeralStorageTabHelper() {
+  ReleaseEphemeralStorage();
+}
 
 void EphemeralStorageTabHelper::ReadyToCommitNavigation(
     NavigationHandle* navigation_handle) {
-  if (!navigation_handle->IsInMainFrame())
+  if (!navigation_handle->IsInMainFrame()) {
+    MaybeCreateStorageNamespacesForFrame(navigation_handle->GetURL());
     return;
+  }
   if (navigation_handle->IsSameDocument())
     return;
 
@@ -97,55 +103,95 @@ void EphemeralStorageTabHelper::CreateEphemeralStorageAreasForDomainAndURL(
   auto* partition =
       BrowserContext::GetStoragePartition(browser_context, site_instance.get());
 
+  ReleaseEphemeralStorage();
+
+  storage_domain_ = new_domain;
+  storage_partition_ = partition;
+  tld_ephemeral_lifetime_ = content::TLDEphemeralLifetime::GetOrCreate(
+      browser_context, partition, new_domain);
+
+  // Session storage of a tab which has an opener starts out as a copy of the
+  // opener's, so it can't wait for a third-party frame to show up.
+  // https://html.spec.whatwg.org/multipage/browsers.html#copy-session-storage
+  if (auto* rfh = web_contents()->GetOpener()) {
+    auto* opener_helper =
+        FromWebContents(WebContents::FromRenderFrameHost(rfh));
+    if (opener_helper && opener_helper->session_storage_namespace_)
+      CreateStorageNamespaces();
+  }
+}
+
+void EphemeralStorageTabHelper::MaybeCreateStorageNamespacesForFrame(
+    const GURL& frame_url) {
+  if (local_storage_namespace_ || !storage_partition_)
+    return;
+
+  // Only third-party frames use ephemeral storage. URLs without a host, like
+  // about:blank, are treated as third-party as their origin may be inherited
+  // from one.
+  if (frame_url.SchemeIsHTTPOrHTTPS() &&
+      net::URLToEphemeralStorageDomain(frame_url) == storage_domain_) {
+    return;
+  }
+
+  CreateStorageNamespaces();
+}
+
+void EphemeralStorageTabHelper::CreateStorageNamespaces() {
+  DCHECK(storage_partition_);
+
   // This will fetch a session storage namespace for this storage partition
   // and storage domain. If another tab helper is already using the same
   // namespace, this will just give us a new reference. When the last tab helper
   // drops the reference, the namespace should be deleted.
   std::string local_partition_id =
-      StringToSessionStorageId(new_domain, kLocalStorageSuffix);
+      StringToSessionStorageId(storage_domain_, kLocalStorageSuffix);
   local_storage_namespace_ = content::CreateSessionStorageNamespace(
-      partition, local_partition_id, base::nullopt);
-
-  // Session storage is always per-tab and never per-TLD, so we always delete
-  // and recreate the session storage when switching domains.
-  //
-  // We need to explicitly release the storage namespace before recreating a
-  // new one in order to make sure that we remove the final reference and free
-  // it.
-  session_storage_namespace_.reset();
+      storage_partition_, local_partition_id, base::nullopt);
 
   std::string session_partition_id = StringToSessionStorageId(
       content::GetSessionStorageNamespaceId(web_contents()),
       kSessionStorageSuffix);
 
-  auto* rfh = web_contents()->GetOpener();
+  // clone the namespace if the opener has one
+  // https://html.spec.whatwg.org/multipage/browsers.html#copy-session-storage
+  base::Optional<std::string> clone_from_id;
+  if (auto* rfh = web_contents()->GetOpener()) {
+    WebContents* opener = WebContents::FromRenderFrameHost(rfh);
+    auto* opener_helper = FromWebContents(opener);
+    if (opener_helper && opener_helper->session_storage_namespace_) {
+      clone_from_id = StringToSessionStorageId(
+          content::GetSessionStorageNamespaceId(opener), kSessionStorageSuffix);
+    }
+  }
   session_storage_namespace_ = content::CreateSessionStorageNamespace(
-      partition, session_partition_id,
-      // clone the namespace if there is an opener
-      // https://html.spec.whatwg.org/multipage/browsers.html#copy-session-storage
-      rfh ? base::make_optional<std::string>(StringToSessionStorageId(
-                content::GetSessionStorageNamespaceId(
-                    WebContents::FromRenderFrameHost(rfh)),
-                kSessionStorageSuffix))
-          : base::nullopt);
-
-  if (base::FeatureList::IsEnabled(
+      storage_partition_, session_partition_id, clone_from_id);
+}
+
+void EphemeralStorageTabHelper::ReleaseEphemeralStorage() {
+  // Session storage is always per-tab and never per-TLD, so it is never kept
+  // alive.
+  session_storage_namespace_.reset();
+
+  if (tld_ephemeral_lifetime_ &&
+      base::FeatureList::IsEnabled(
           net::features::kBraveEphemeralStorageKeepAlive)) {
     // keep the ephemeral storage alive for some time to handle redirects
     // including meta refresh or other page driven "redirects" that end up back
-    // at the original origin
-    base::SequencedTaskRunnerHandle::Get()->PostDelayedTask(
-        FROM_HERE,
-        base::BindOnce([](scoped_refptr<content::TLDEphemeralLifetime>
-                              tld_ephemeral_lifetime) {},
-                       tld_ephemeral_lifetime_),
-        g_storage_keep_alive_for_testing.is_min()
-            ? kStorageKeepAliveDelay
-            : g_storage_keep_alive_for_testing);
+    // at the original origin. The service is per BrowserContext and releases
+    // whatever it still holds when the profile shuts down.
+    const base::TimeDelta delay = g_storage_keep_alive_for_testing.is_min()
+                                      ? kStorageKeepAliveDelay
+                                      : g_storage_keep_alive_for_testing;
+    if (auto* service = EphemeralStorageServiceFactory::GetForBrowserContext(
+            browser_context_)) {
+      service->KeepAlive(std::move(tld_ephemeral_lifetime_),
+                         std::move(local_storage_namespace_), delay);
+    }
   }
 
-  tld_ephemeral_lifetime_ = content::TLDEphemeralLifetime::GetOrCreate(
-      browser_context, partition, new_domain);
+  local_storage_namespace_.reset();
+  tld_ephemeral_lifetime_.reset();
 }
 
 // static
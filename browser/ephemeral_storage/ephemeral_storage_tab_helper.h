@@ -16,6 +16,7 @@
 
 namespace content {
 class BrowserContext;
+class StoragePartition;
 class WebContents;
 }  // namespace content
 
@@ -25,7 +26,8 @@ namespace ephemeral_storage {
 // Ephemeral storage is a partitioned storage area only used by third-party
 // iframes. This storage is partitioned based on the origin of the TLD
 // of the main frame. When no more tabs are open with a particular origin,
-// this storage is cleared.
+// this storage is cleared. The local and session storage namespaces are only
+// created once a third-party frame commits in the tab.
 class EphemeralStorageTabHelper
     : public content::WebContentsObserver,
       public content::WebContentsUserData<EphemeralStorageTabHelper> {
@@ -42,8 +44,15 @@ class EphemeralStorageTabHelper
  private:
   void CreateEphemeralStorageAreasForDomainAndURL(std::string new_domain,
                                                   const GURL& new_url);
+  void MaybeCreateStorageNamespacesForFrame(const GURL& frame_url);
+  void CreateStorageNamespaces();
+  void ReleaseEphemeralStorage();
 
   friend class content::WebContentsUserData<EphemeralStorageTabHelper>;
+  // Kept for the destructor, which runs once web_contents() is already null.
+  content::BrowserContext* browser_context_;  // not owned
+  std::string storage_domain_;
+  content::StoragePartition* storage_partition_ = nullptr;  // not owned
   scoped_refptr<content::SessionStorageNamespace> local_storage_namespace_;
   scoped_refptr<content::SessionStorageNamespace> session_storage_namespace_;
   scoped_refptr<content::TLDEphemeralLifetime> tld_ephemeral_lifetime_;
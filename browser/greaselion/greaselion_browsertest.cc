@@ -3,6 +3,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <map>
+
 #include "base/containers/flat_map.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
@@ -23,6 +25,7 @@
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_registry.h"
 #include "net/dns/mock_host_resolver.h"
 #include "ui/base/ui_base_switches.h"
 
@@ -354,6 +357,45 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsGreaselionExtension) {
   EXPECT_TRUE(greaselion_service->IsGreaselionExtension(extension_ids[0]));
 }
 
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       FeatureChangeKeepsUnaffectedExtensions) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  ASSERT_TRUE(greaselion_service);
+  extensions::ExtensionRegistry* registry =
+      extensions::ExtensionRegistry::Get(profile());
+
+  auto extension_ids = greaselion_service->GetExtensionIdsForTesting();
+  ASSERT_GT(extension_ids.size(), 0UL);
+  std::map<std::string, const extensions::Extension*> installed;
+  for (const auto& id : extension_ids) {
+    installed[id] = registry->enabled_extensions().GetByID(id);
+    ASSERT_TRUE(installed[id]);
+  }
+
+  // Only the rule with the auto contribution precondition is installed, the
+  // other extensions are left alone.
+  greaselion_service->SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, true);
+  GreaselionServiceWaiter(greaselion_service).Wait();
+  EXPECT_EQ(extension_ids.size() + 1,
+            greaselion_service->GetExtensionIdsForTesting().size());
+  for (const auto& extension : installed) {
+    EXPECT_EQ(extension.second,
+              registry->enabled_extensions().GetByID(extension.first));
+  }
+
+  // And only that one is removed again.
+  greaselion_service->SetFeatureEnabled(greaselion::AUTO_CONTRIBUTION, false);
+  GreaselionServiceWaiter(greaselion_service).Wait();
+  EXPECT_EQ(extension_ids, greaselion_service->GetExtensionIdsForTesting());
+  for (const auto& extension : installed) {
+    EXPECT_EQ(extension.second,
+              registry->enabled_extensions().GetByID(extension.first));
+  }
+}
+
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsNotGreaselionExtension) {
   ASSERT_TRUE(InstallMockExtension());
 
@@ -3,6 +3,11 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "base/barrier_closure.h"
 #include "base/base64.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
@@ -156,6 +161,14 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     return http_response;
   }
 
+  std::unique_ptr<net::test_server::HttpResponse> HandleCountedGetRepoStats(
+      const net::test_server::HttpRequest& request) {
+    auto http_response = HandleGetRepoStats(request);
+    if (http_response)
+      repo_stats_requests_++;
+    return http_response;
+  }
+
   std::unique_ptr<net::test_server::HttpResponse> HandleGetNodeInfo(
       const net::test_server::HttpRequest& request) {
     const GURL gurl = request.GetURL();
@@ -200,6 +213,15 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     return http_response;
   }
 
+  std::unique_ptr<net::test_server::HttpResponse>
+  HandleCountedGetRepoStatsAndGarbageCollection(
+      const net::test_server::HttpRequest& request) {
+    auto http_response = HandleCountedGetRepoStats(request);
+    if (http_response)
+      return http_response;
+    return HandleGarbageCollection(request);
+  }
+
   std::unique_ptr<net::test_server::HttpResponse> HandleRequestServerError(
       const net::test_server::HttpRequest& request) {
     auto http_response =
@@ -397,6 +419,8 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     ASSERT_FALSE(success);
   }
 
+  int repo_stats_requests() const { return repo_stats_requests_; }
+
   void WaitForRequest() {
     if (wait_for_request_) {
       return;
@@ -407,6 +431,8 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
   }
 
  private:
+  // Written on the embedded test server thread.
+  std::atomic<int> repo_stats_requests_{0};
   std::unique_ptr<base::RunLoop> wait_for_request_;
   std::unique_ptr<net::EmbeddedTestServer> test_server_;
   IpfsService* ipfs_service_;
@@ -485,6 +511,41 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GetRepoStatsServerError) {
   WaitForRequest();
 }
 
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GetRepoStatsCoalesced) {
+  ResetTestServer(
+      base::BindRepeating(&IpfsServiceBrowserTest::HandleCountedGetRepoStats,
+                          base::Unretained(this)));
+
+  const int kRequestCount = 50;
+
+  base::RunLoop run_loop;
+  auto barrier = base::BarrierClosure(kRequestCount, run_loop.QuitClosure());
+  for (int i = 0; i < kRequestCount; i++) {
+    ipfs_service()->GetRepoStats(base::BindOnce(
+        [](base::RepeatingClosure barrier, bool success,
+           const RepoStats& stats) {
+          EXPECT_TRUE(success);
+          EXPECT_EQ(stats.objects, uint64_t(113));
+          barrier.Run();
+        },
+        barrier));
+  }
+  run_loop.Run();
+
+  EXPECT_EQ(repo_stats_requests(), 1);
+
+  // A fresh response is served from the cache.
+  base::RunLoop cached_run_loop;
+  ipfs_service()->GetRepoStats(base::BindOnce(
+      [](base::OnceClosure quit, bool success, const RepoStats& stats) {
+        EXPECT_TRUE(success);
+        std::move(quit).Run();
+      },
+      cached_run_loop.QuitClosure()));
+  cached_run_loop.Run();
+  EXPECT_EQ(repo_stats_requests(), 1);
+}
+
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GetNodeInfoServerSuccess) {
   ResetTestServer(base::BindRepeating(
       &IpfsServiceBrowserTest::HandleGetNodeInfo, base::Unretained(this)));
@@ -524,6 +585,40 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, RunGarbageCollectionError) {
   WaitForRequest();
 }
 
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest,
+                       GarbageCollectionInvalidatesRepoStats) {
+  ResetTestServer(base::BindRepeating(
+      &IpfsServiceBrowserTest::HandleCountedGetRepoStatsAndGarbageCollection,
+      base::Unretained(this)));
+
+  auto get_repo_stats = [](IpfsService* service) {
+    base::RunLoop run_loop;
+    service->GetRepoStats(base::BindOnce(
+        [](base::OnceClosure quit, bool success, const RepoStats& stats) {
+          EXPECT_TRUE(success);
+          std::move(quit).Run();
+        },
+        run_loop.QuitClosure()));
+    run_loop.Run();
+  };
+
+  get_repo_stats(ipfs_service());
+  EXPECT_EQ(repo_stats_requests(), 1);
+
+  base::RunLoop run_loop;
+  ipfs_service()->RunGarbageCollection(base::BindOnce(
+      [](base::OnceClosure quit, bool success, const std::string& error) {
+        EXPECT_TRUE(success);
+        std::move(quit).Run();
+      },
+      run_loop.QuitClosure()));
+  run_loop.Run();
+
+  // The stats cached before the garbage collection aren't reused.
+  get_repo_stats(ipfs_service());
+  EXPECT_EQ(repo_stats_requests(), 2);
+}
+
 // Make sure an ipfs:// window.fetch does not work within the http:// scheme
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest,
                        CannotFetchIPFSResourcesFromHTTP) {
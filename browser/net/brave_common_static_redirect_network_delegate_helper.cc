@@ -11,8 +11,10 @@
 
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "brave/browser/net/url_rule_matcher.h"
 #include "brave/common/network_constants.h"
 #include "brave/components/brave_component_updater/browser/features.h"
 #include "brave/components/brave_component_updater/browser/switches.h"
@@ -47,25 +49,38 @@ std::string GetUpdateURLHost() {
   return UPDATER_DEV_ENDPOINT;
 }
 
-// Update server checks happen from the profile context for admin policy
-// installed extensions. Update server checks happen from the system context for
-// normal update operations.
-bool IsUpdaterURL(const GURL& gurl) {
-  static std::vector<URLPattern> updater_patterns(
-      {URLPattern(URLPattern::SCHEME_HTTPS,
-                  std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"),
-       URLPattern(
-           URLPattern::SCHEME_HTTP,
-           std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"),
+enum CommonStaticRedirectRule {
+  kUpdaterRule,
+  kChromeCastRule,
+  kClients4Rule,
+  kBugsChromiumRule
+};
+
+// Rules are listed in priority order, the first matching rule wins
+const URLRuleMatcher& GetCommonStaticRedirectMatcher() {
+  const int kHttpOrHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+  // Update server checks happen from the profile context for admin policy
+  // installed extensions. Update server checks happen from the system context
+  // for normal update operations.
+  static const base::NoDestructor<URLRuleMatcher> matcher(
+      std::vector<URLRuleMatcher::Rule>({
+          {kUpdaterRule, URLPattern::SCHEME_HTTPS,
+           std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"},
+          {kUpdaterRule, URLPattern::SCHEME_HTTP,
+           std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"},
 #if BUILDFLAG(ENABLE_EXTENSIONS)
-       URLPattern(
-           URLPattern::SCHEME_HTTPS,
-           std::string(extension_urls::kChromeWebstoreUpdateURL) + "*")
+          {kUpdaterRule, URLPattern::SCHEME_HTTPS,
+           std::string(extension_urls::kChromeWebstoreUpdateURL) + "*"},
 #endif
-  });
-  return std::any_of(
-      updater_patterns.begin(), updater_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
+          {kChromeCastRule, kHttpOrHttps, kChromeCastPrefix},
+          {kClients4Rule, kHttpOrHttps, kClients4Prefix,
+           URLRuleMatcher::MatchType::kHost},
+          {kBugsChromiumRule, kHttpOrHttps,
+           "*://bugs.chromium.org/p/chromium/issues/entry?*"},
+      }));
+
+  return *matcher;
 }
 
 bool RewriteBugReportingURL(const GURL& request_url, GURL* new_url) {
@@ -116,44 +131,40 @@ int OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(
   DCHECK(new_url);
 
   GURL::Replacements replacements;
-  static URLPattern chromecast_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kChromeCastPrefix);
-  static URLPattern clients4_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kClients4Prefix);
-  static URLPattern bugsChromium_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      "*://bugs.chromium.org/p/chromium/issues/entry?*");
-
-  if (IsUpdaterURL(request_url)) {
-    auto update_host = GetUpdateURLHost();
-    if (!update_host.empty()) {
-      replacements.SetQueryStr(request_url.query_piece());
-      *new_url = GURL(update_host).ReplaceComponents(replacements);
+
+  switch (GetCommonStaticRedirectMatcher().Match(request_url)) {
+    case kUpdaterRule: {
+      auto update_host = GetUpdateURLHost();
+      if (!update_host.empty()) {
+        replacements.SetQueryStr(request_url.query_piece());
+        *new_url = GURL(update_host).ReplaceComponents(replacements);
+      }
+      return net::OK;
     }
-    return net::OK;
-  }
 
-  if (chromecast_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+    case kChromeCastRule: {
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveRedirectorProxy);
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
+    }
 
-  if (clients4_pattern.MatchesHost(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveClients4Proxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+    case kClients4Rule: {
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveClients4Proxy);
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
+    }
 
-  if (bugsChromium_pattern.MatchesURL(request_url)) {
-    if (RewriteBugReportingURL(request_url, new_url))
+    case kBugsChromiumRule: {
+      RewriteBugReportingURL(request_url, new_url);
       return net::OK;
-  }
+    }
 
-  return net::OK;
+    default: {
+      return net::OK;
+    }
+  }
 }
 
-
 }  // namespace brave
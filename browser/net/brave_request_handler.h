@@ -17,6 +17,10 @@
 
 class PrefChangeRegistrar;
 
+namespace brave {
+class ReferralHeaders;
+}  // namespace brave
+
 // Contains different network stack hooks (similar to capabilities of WebRequest
 // API).
 class BraveRequestHandler {
@@ -64,7 +68,9 @@ class BraveRequestHandler {
   // rewards service. Eliminating this will also help to avoid using
   // PrefChangeRegistrar and corresponding |base::Unretained| usages, that are
   // illegal.
-  std::unique_ptr<base::ListValue> referral_headers_list_;
+  // Replaced rather than modified when the pref changes, so requests in flight
+  // keep using the headers they started with.
+  std::shared_ptr<const brave::ReferralHeaders> referral_headers_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
   std::unique_ptr<PrefChangeRegistrar, content::BrowserThread::DeleteOnUIThread>
       pref_change_registrar_;
@@ -13,6 +13,7 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_util.h"
+#include "brave/browser/net/url_rule_matcher.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/url_constants.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -29,13 +30,12 @@ namespace brave {
 namespace {
 
 bool IsUAWhitelisted(const GURL& gurl) {
-  static std::vector<URLPattern> whitelist_patterns(
-      {URLPattern(URLPattern::SCHEME_ALL, "https://*.duckduckgo.com/*"),
-       // For Widevine
-       URLPattern(URLPattern::SCHEME_ALL, "https://*.netflix.com/*")});
-  return std::any_of(
-      whitelist_patterns.begin(), whitelist_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
+  static const base::NoDestructor<URLRuleMatcher> whitelist_matcher(
+      std::vector<URLRuleMatcher::Rule>(
+          {{0, URLPattern::SCHEME_ALL, "https://*.duckduckgo.com/*"},
+           // For Widevine
+           {0, URLPattern::SCHEME_ALL, "https://*.netflix.com/*"}}));
+  return whitelist_matcher->Match(gurl) != URLRuleMatcher::kNoRule;
 }
 
 const std::string& GetQueryStringTrackers() {
@@ -5,12 +5,13 @@
 
 #include "brave/browser/net/brave_static_redirect_network_delegate_helper.h"
 
-#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "base/no_destructor.h"
 #include "base/strings/string_piece_forward.h"
+#include "brave/browser/net/url_rule_matcher.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/translate_network_constants.h"
@@ -31,6 +32,59 @@ base::StringPiece GetSafeBrowsingEndpoint() {
   return SAFEBROWSING_ENDPOINT;
 }
 
+enum StaticRedirectRule {
+  kGeoLocationRule,
+  kSafeBrowsingRule,
+  kSafeBrowsingFileCheckRule,
+  kSafeBrowsingCrxListRule,
+  kCRXDownloadRule,
+  kAutofillRule,
+  kCRLSetRule,
+  kWidevineRule,
+  kRedirectorProxyRule,
+  kTranslateRule,
+  kTranslateLanguageRule
+};
+
+// Rules are listed in priority order, the first matching rule wins
+const URLRuleMatcher& GetStaticRedirectMatcher() {
+  const int kHttpOrHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+  const auto kHost = URLRuleMatcher::MatchType::kHost;
+
+  // To-Do (@jumde) - Update the naming for the CRLSet constants
+  // https://github.com/brave/brave-browser/issues/10314
+  static const base::NoDestructor<URLRuleMatcher> matcher(
+      std::vector<URLRuleMatcher::Rule>({
+          {kGeoLocationRule, URLPattern::SCHEME_HTTPS, kGeoLocationsPattern},
+          {kSafeBrowsingRule, URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix,
+           kHost},
+          {kSafeBrowsingFileCheckRule, URLPattern::SCHEME_HTTPS,
+           kSafeBrowsingFileCheckPrefix, kHost},
+          {kSafeBrowsingCrxListRule, URLPattern::SCHEME_HTTPS,
+           kSafeBrowsingCrxListPrefix, kHost},
+          {kCRXDownloadRule, kHttpOrHttps, kCRXDownloadPrefix},
+          {kAutofillRule, URLPattern::SCHEME_HTTPS, kAutofillPrefix},
+          {kCRLSetRule, kHttpOrHttps, kCRLSetPrefix1},
+          {kCRLSetRule, kHttpOrHttps, kCRLSetPrefix2},
+          {kCRLSetRule, kHttpOrHttps, kCRLSetPrefix3},
+          {kCRLSetRule, kHttpOrHttps, kCRLSetPrefix4},
+          // Widevine is downloaded from Google directly, so it must take
+          // precedence over the gvt1.com and dl.google.com redirects below
+          {kWidevineRule, kHttpOrHttps, kWidevineGvt1Prefix},
+          {kWidevineRule, kHttpOrHttps, kWidevineGoogleDlPrefix},
+          {kRedirectorProxyRule, kHttpOrHttps, "*://*.gvt1.com/*"},
+          {kRedirectorProxyRule, kHttpOrHttps, "*://dl.google.com/*"},
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+          {kTranslateRule, URLPattern::SCHEME_HTTPS,
+           kTranslateElementJSPattern},
+          {kTranslateLanguageRule, URLPattern::SCHEME_HTTPS,
+           kTranslateLanguagePattern},
+#endif
+      }));
+
+  return *matcher;
+}
+
 }  // namespace
 
 void SetSafeBrowsingEndpointForTesting(bool testing) {
@@ -53,149 +107,89 @@ int OnBeforeURLRequest_StaticRedirectWorkForGURL(
     const GURL& request_url,
     GURL* new_url) {
   GURL::Replacements replacements;
-  static URLPattern geo_pattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
-  static URLPattern safeBrowsing_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingPrefix);
-  static URLPattern safebrowsingfilecheck_pattern(URLPattern::SCHEME_HTTPS,
-                                                  kSafeBrowsingFileCheckPrefix);
-  static URLPattern safebrowsingcrxlist_pattern(URLPattern::SCHEME_HTTPS,
-                                                kSafeBrowsingCrxListPrefix);
-
-  // To-Do (@jumde) - Update the naming for the variables below
-  // https://github.com/brave/brave-browser/issues/10314
-  static URLPattern crlSet_pattern1(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix1);
-  static URLPattern crlSet_pattern2(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix2);
-  static URLPattern crlSet_pattern3(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix3);
-  static URLPattern crlSet_pattern4(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix4);
-  static URLPattern crxDownload_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRXDownloadPrefix);
-  static URLPattern autofill_pattern(
-      URLPattern::SCHEME_HTTPS, kAutofillPrefix);
-  static URLPattern gvt1_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, "*://*.gvt1.com/*");
-  static URLPattern googleDl_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      "*://dl.google.com/*");
-
-  static URLPattern widevine_gvt1_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      kWidevineGvt1Prefix);
-  static URLPattern widevine_google_dl_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      kWidevineGoogleDlPrefix);
 
-#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  static URLPattern translate_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateElementJSPattern);
-  static URLPattern translate_language_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateLanguagePattern);
-#endif
-  if (geo_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
-    return net::OK;
-  }
-
-  auto safebrowsing_endpoint = GetSafeBrowsingEndpoint();
-  if (!safebrowsing_endpoint.empty() &&
-      safeBrowsing_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(safebrowsing_endpoint);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (!safebrowsing_endpoint.empty() &&
-      safebrowsingfilecheck_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(kBraveSafeBrowsingSslProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (!safebrowsing_endpoint.empty() &&
-      safebrowsingcrxlist_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(kBraveSafeBrowsing2Proxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crxDownload_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crxdownload.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (autofill_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveStaticProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern1.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern2.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern3.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern4.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (gvt1_pattern.MatchesURL(request_url) &&
-      !widevine_gvt1_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (googleDl_pattern.MatchesURL(request_url) &&
-      !widevine_google_dl_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+  switch (GetStaticRedirectMatcher().Match(request_url)) {
+    case kGeoLocationRule: {
+      *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
+      return net::OK;
+    }
+
+    case kSafeBrowsingRule: {
+      auto safebrowsing_endpoint = GetSafeBrowsingEndpoint();
+      if (!safebrowsing_endpoint.empty()) {
+        replacements.SetHostStr(safebrowsing_endpoint);
+        *new_url = request_url.ReplaceComponents(replacements);
+      }
+      return net::OK;
+    }
+
+    case kSafeBrowsingFileCheckRule: {
+      if (!GetSafeBrowsingEndpoint().empty()) {
+        replacements.SetHostStr(kBraveSafeBrowsingSslProxy);
+        *new_url = request_url.ReplaceComponents(replacements);
+      }
+      return net::OK;
+    }
+
+    case kSafeBrowsingCrxListRule: {
+      if (!GetSafeBrowsingEndpoint().empty()) {
+        replacements.SetHostStr(kBraveSafeBrowsing2Proxy);
+        *new_url = request_url.ReplaceComponents(replacements);
+      }
+      return net::OK;
+    }
+
+    case kCRXDownloadRule: {
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr("crxdownload.brave.com");
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
+    }
+
+    case kAutofillRule: {
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveStaticProxy);
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
+    }
+
+    case kCRLSetRule: {
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr("crlsets.brave.com");
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
+    }
+
+    case kWidevineRule: {
+      return net::OK;
+    }
+
+    case kRedirectorProxyRule: {
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr(kBraveRedirectorProxy);
+      *new_url = request_url.ReplaceComponents(replacements);
+      return net::OK;
+    }
 
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  if (translate_pattern.MatchesURL(request_url)) {
-    replacements.SetQueryStr(request_url.query_piece());
-    replacements.SetPathStr(request_url.path_piece());
-    *new_url =
-      GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (translate_language_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(kBraveTranslateLanguageEndpoint);
-    return net::OK;
-  }
+    case kTranslateRule: {
+      replacements.SetQueryStr(request_url.query_piece());
+      replacements.SetPathStr(request_url.path_piece());
+      *new_url =
+        GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements);
+      return net::OK;
+    }
+
+    case kTranslateLanguageRule: {
+      *new_url = GURL(kBraveTranslateLanguageEndpoint);
+      return net::OK;
+    }
 #endif
 
-  return net::OK;
+    default: {
+      return net::OK;
+    }
+  }
 }
 
-
 }  // namespace brave
@@ -108,10 +108,9 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
   // (See |BraveProxyingWebSocket|).
   if (ctx->tab_origin.is_empty()) {
     ctx->tab_origin = brave_shields::BraveShieldsWebContentsObserver::
-                          GetTabURLFromRenderFrameInfo(ctx->render_process_id,
-                                                       ctx->render_frame_id,
-                                                       ctx->frame_tree_node_id)
-                              .GetOrigin();
+        GetTabOriginFromRenderFrameInfo(ctx->render_process_id,
+                                        ctx->render_frame_id,
+                                        ctx->frame_tree_node_id);
   }
 
   if (old_ctx) {
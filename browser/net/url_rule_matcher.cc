@@ -0,0 +1,120 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_rule_matcher.h"
+
+#include <map>
+
+#include "base/logging.h"
+
+namespace brave {
+
+URLRuleMatcher::Rule::Rule(int id,
+                           int valid_schemes,
+                           base::StringPiece pattern,
+                           MatchType match_type)
+    : id(id), pattern(valid_schemes, pattern), match_type(match_type) {
+  DCHECK_NE(kNoRule, id);
+}
+
+URLRuleMatcher::Rule::Rule(const Rule& other) = default;
+
+URLRuleMatcher::Rule::~Rule() = default;
+
+URLRuleMatcher::URLRuleMatcher(const std::vector<Rule>& rules)
+    : rules_(rules) {
+  std::map<std::string, std::vector<size_t>> host_index;
+  for (size_t i = 0; i < rules_.size(); i++) {
+    const std::string& host = rules_[i].pattern.host();
+    if (host.empty()) {
+      any_host_rules_.push_back(i);
+    } else {
+      host_index[host].push_back(i);
+    }
+  }
+
+  host_index_ = base::flat_map<std::string, std::vector<size_t>, std::less<>>(
+      host_index.begin(), host_index.end());
+}
+
+URLRuleMatcher::~URLRuleMatcher() = default;
+
+int URLRuleMatcher::Match(const GURL& url) const {
+  size_t best = rules_.size();
+
+  base::StringPiece host = url.host_piece();
+  if (!host.empty() && host.back() == '.') {
+    host.remove_suffix(1);
+  }
+
+  // Walk up the domain, i.e. "a.b.example.com", "b.example.com",
+  // "example.com" and "com". Only the exact host may match patterns without a
+  // subdomain wildcard
+  bool subdomains_only = false;
+  while (!host.empty()) {
+    const auto iter = host_index_.find(host);
+    if (iter != host_index_.end()) {
+      MatchCandidates(iter->second, url, subdomains_only, &best);
+    }
+
+    const size_t pos = host.find('.');
+    if (pos == base::StringPiece::npos) {
+      break;
+    }
+
+    host.remove_prefix(pos + 1);
+    subdomains_only = true;
+  }
+
+  MatchCandidates(any_host_rules_, url, false, &best);
+
+  if (best == rules_.size()) {
+    return kNoRule;
+  }
+
+  return rules_[best].id;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool URLRuleMatcher::Matches(const size_t index, const GURL& url) const {
+  const Rule& rule = rules_[index];
+  switch (rule.match_type) {
+    case MatchType::kURL: {
+      return rule.pattern.MatchesURL(url);
+    }
+
+    case MatchType::kHost: {
+      return rule.pattern.MatchesHost(url);
+    }
+  }
+
+  NOTREACHED();
+  return false;
+}
+
+void URLRuleMatcher::MatchCandidates(const std::vector<size_t>& candidates,
+                                     const GURL& url,
+                                     const bool subdomains_only,
+                                     size_t* best) const {
+  DCHECK(best);
+
+  for (const size_t index : candidates) {
+    if (index >= *best) {
+      return;
+    }
+
+    if (subdomains_only && !rules_[index].pattern.match_subdomains()) {
+      continue;
+    }
+
+    if (Matches(index, url)) {
+      *best = index;
+      return;
+    }
+  }
+}
+
+}  // namespace brave
@@ -0,0 +1,78 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_URL_RULE_MATCHER_H_
+#define BRAVE_BROWSER_NET_URL_RULE_MATCHER_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/strings/string_piece.h"
+#include "extensions/common/url_pattern.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+// Matches URLs against an ordered list of URL patterns, each tagged with a
+// caller defined rule id. Patterns are indexed by host so a lookup only
+// evaluates the patterns registered for the request host and its parent
+// domains, instead of every pattern in the list. When several patterns match,
+// the one added first wins, which keeps the semantics of an if/else chain.
+class URLRuleMatcher {
+ public:
+  static constexpr int kNoRule = -1;
+
+  enum class MatchType {
+    // Matches scheme, host and path, see |URLPattern::MatchesURL|
+    kURL,
+    // Only matches the host, see |URLPattern::MatchesHost|
+    kHost
+  };
+
+  struct Rule {
+    Rule(int id,
+         int valid_schemes,
+         base::StringPiece pattern,
+         MatchType match_type = MatchType::kURL);
+    Rule(const Rule& other);
+    ~Rule();
+
+    int id;
+    URLPattern pattern;
+    MatchType match_type;
+  };
+
+  explicit URLRuleMatcher(const std::vector<Rule>& rules);
+  ~URLRuleMatcher();
+
+  URLRuleMatcher(const URLRuleMatcher&) = delete;
+  URLRuleMatcher& operator=(const URLRuleMatcher&) = delete;
+
+  // Returns the id of the first rule matching |url|, or |kNoRule|
+  int Match(const GURL& url) const;
+
+ private:
+  bool Matches(const size_t index, const GURL& url) const;
+
+  // Lowers |best| to the first index in |candidates| which matches |url|
+  void MatchCandidates(const std::vector<size_t>& candidates,
+                       const GURL& url,
+                       const bool subdomains_only,
+                       size_t* best) const;
+
+  std::vector<Rule> rules_;
+
+  // Rule indices by pattern host, in ascending order
+  base::flat_map<std::string, std::vector<size_t>, std::less<>> host_index_;
+
+  // Rule indices for patterns without a host, such as "*://*/*"
+  std::vector<size_t> any_host_rules_;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_URL_RULE_MATCHER_H_
@@ -0,0 +1,123 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_rule_matcher.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave::URLRuleMatcher;
+
+namespace {
+
+const int kHttpOrHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+std::vector<URLRuleMatcher::Rule> GetRules() {
+  return {
+      {1, kHttpOrHttps, "*://dl.google.com/release2/chrome_component/*"},
+      {2, kHttpOrHttps, "*://*.gvt1.com/*widevine*"},
+      {3, kHttpOrHttps, "*://*.gvt1.com/*"},
+      {4, kHttpOrHttps, "*://dl.google.com/*"},
+      {5, URLPattern::SCHEME_HTTPS, "https://safebrowsing.googleapis.com/",
+       URLRuleMatcher::MatchType::kHost},
+      {6, URLPattern::SCHEME_HTTPS, "https://www.gstatic.com/autofill/*"},
+      {7, URLPattern::SCHEME_ALL, "*://*/*.crx"},
+  };
+}
+
+// Evaluates every rule in order, like the if/else chains the matcher replaces
+int MatchLinearly(const std::vector<URLRuleMatcher::Rule>& rules,
+                  const GURL& url) {
+  for (const auto& rule : rules) {
+    const bool matches = rule.match_type == URLRuleMatcher::MatchType::kHost
+                             ? rule.pattern.MatchesHost(url)
+                             : rule.pattern.MatchesURL(url);
+    if (matches) {
+      return rule.id;
+    }
+  }
+
+  return URLRuleMatcher::kNoRule;
+}
+
+}  // namespace
+
+TEST(URLRuleMatcherTest, NoRules) {
+  const URLRuleMatcher matcher((std::vector<URLRuleMatcher::Rule>()));
+  EXPECT_EQ(URLRuleMatcher::kNoRule, matcher.Match(GURL("https://brave.com")));
+}
+
+TEST(URLRuleMatcherTest, MatchesExactHost) {
+  const URLRuleMatcher matcher(GetRules());
+  EXPECT_EQ(4, matcher.Match(GURL("https://dl.google.com/foo")));
+  EXPECT_EQ(URLRuleMatcher::kNoRule,
+            matcher.Match(GURL("https://www.dl.google.com/foo")));
+}
+
+TEST(URLRuleMatcherTest, MatchesSubdomains) {
+  const URLRuleMatcher matcher(GetRules());
+  EXPECT_EQ(3, matcher.Match(GURL("https://gvt1.com/foo")));
+  EXPECT_EQ(3, matcher.Match(GURL("https://r1---sn-abc.gvt1.com/foo")));
+  EXPECT_EQ(URLRuleMatcher::kNoRule,
+            matcher.Match(GURL("https://notgvt1.com/foo")));
+}
+
+TEST(URLRuleMatcherTest, FirstMatchingRuleWins) {
+  const URLRuleMatcher matcher(GetRules());
+  EXPECT_EQ(1, matcher.Match(GURL(
+                   "https://dl.google.com/release2/chrome_component/crl")));
+  EXPECT_EQ(2, matcher.Match(GURL("https://r1.gvt1.com/widevine/cdm")));
+  EXPECT_EQ(3, matcher.Match(GURL("https://r1.gvt1.com/foo.crx")));
+  EXPECT_EQ(7, matcher.Match(GURL("https://brave.com/foo.crx")));
+}
+
+TEST(URLRuleMatcherTest, MatchesHostOnly) {
+  const URLRuleMatcher matcher(GetRules());
+  EXPECT_EQ(5, matcher.Match(GURL("https://safebrowsing.googleapis.com/v4")));
+  EXPECT_EQ(5, matcher.Match(GURL("http://safebrowsing.googleapis.com/")));
+}
+
+TEST(URLRuleMatcherTest, RespectsSchemes) {
+  const URLRuleMatcher matcher(GetRules());
+  EXPECT_EQ(6, matcher.Match(GURL("https://www.gstatic.com/autofill/foo")));
+  EXPECT_EQ(URLRuleMatcher::kNoRule,
+            matcher.Match(GURL("http://www.gstatic.com/autofill/foo")));
+  EXPECT_EQ(URLRuleMatcher::kNoRule,
+            matcher.Match(GURL("ftp://dl.google.com/foo")));
+}
+
+TEST(URLRuleMatcherTest, MatchesLinearEvaluation) {
+  const std::vector<URLRuleMatcher::Rule> rules = GetRules();
+  const URLRuleMatcher matcher(rules);
+
+  const std::vector<std::string> urls = {
+      "https://brave.com/",
+      "https://www.google.com/search?q=brave",
+      "https://www.gstatic.com/images/branding/logo.png",
+      "https://www.gstatic.com/autofill/hash/abc",
+      "http://www.gstatic.com/autofill/hash/abc",
+      "https://safebrowsing.googleapis.com/v4/threatListUpdates:fetch",
+      "https://dl.google.com/release2/chrome_component/abc/crl-set",
+      "https://dl.google.com/widevine-cdm/4.10.1610.0-linux-x64.zip",
+      "http://dl.google.com/foo.crx",
+      "https://redirector.gvt1.com/edgedl/release2/chrome_component/abc",
+      "https://r5---sn-p5qlsnd6.gvt1.com/widevine/cdm.zip",
+      "https://gvt1.com/",
+      "https://example.com/extension.crx",
+      "https://cdn.example.com/a/b/c/d/e/f.js?x=1",
+      "wss://dl.google.com/socket",
+      "data:text/plain,foo",
+      "file:///tmp/foo.crx",
+      "https://192.168.1.1/router.crx",
+  };
+
+  for (const auto& url : urls) {
+    EXPECT_EQ(MatchLinearly(rules, GURL(url)), matcher.Match(GURL(url)))
+        << url;
+  }
+}
@@ -55,6 +55,9 @@ using ntp_background_images::ViewCounterServiceFactory;
 
 namespace {
 
+constexpr base::TimeDelta kStatsUpdateDelay =
+    base::TimeDelta::FromMilliseconds(500);
+
 bool IsPrivateNewTab(Profile* profile) {
   return profile->IsIncognitoProfile() || profile->IsGuestSession();
 }
@@ -363,6 +366,7 @@ void BraveNewTabMessageHandler::OnJavascriptAllowed() {
 
 void BraveNewTabMessageHandler::OnJavascriptDisallowed() {
   pref_change_registrar_.RemoveAll();
+  stats_update_timer_.Stop();
 #if BUILDFLAG(ENABLE_TOR)
   if (tor_launcher_factory_)
     tor_launcher_factory_->RemoveObserver(this);
@@ -534,6 +538,15 @@ void BraveNewTabMessageHandler::HandleGetBrandedWallpaperData(
     const std::string wallpaper_id = base::GenerateGUID();
     data.SetStringKey(ntp_background_images::kWallpaperIDKey, wallpaper_id);
     service->BrandedWallpaperWillBeDisplayed(wallpaper_id);
+
+    const base::Value next_wallpaper = service->GetNextWallpaper();
+    if (next_wallpaper.is_dict()) {
+      if (const std::string* next_image_url = next_wallpaper.FindStringKey(
+              ntp_background_images::kWallpaperImageURLKey)) {
+        data.SetStringKey(ntp_background_images::kNextWallpaperImageURLKey,
+                          *next_image_url);
+      }
+    }
   }
 
   ResolveJavascriptCallback(args->GetList()[0], std::move(data));
@@ -644,6 +657,19 @@ void BraveNewTabMessageHandler::OnPrivatePropertiesChanged() {
 }
 
 void BraveNewTabMessageHandler::OnStatsChanged() {
+  // Every blocked resource bumps a counter, so send the page one update per
+  // burst instead of one per request
+  if (stats_update_timer_.IsRunning()) {
+    return;
+  }
+
+  stats_update_timer_.Start(
+      FROM_HERE, kStatsUpdateDelay,
+      base::BindOnce(&BraveNewTabMessageHandler::UpdateStats,
+                     base::Unretained(this)));
+}
+
+void BraveNewTabMessageHandler::UpdateStats() {
   PrefService* prefs = profile_->GetPrefs();
   auto data = GetStatsDictionary(prefs);
   FireWebUIListener("stats-updated", data);
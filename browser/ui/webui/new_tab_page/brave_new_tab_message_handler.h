@@ -8,6 +8,7 @@
 
 #include <string>
 
+#include "base/timer/timer.h"
 #include "brave/components/tor/buildflags/buildflags.h"
 #include "brave/components/tor/tor_launcher_observer.h"
 #include "components/prefs/pref_change_registrar.h"
@@ -63,6 +64,7 @@ class BraveNewTabMessageHandler : public content::WebUIMessageHandler,
   void HandleTodayOnPromotedCardView(const base::ListValue* args);
 
   void OnStatsChanged();
+  void UpdateStats();
   void OnPreferencesChanged();
   void OnPrivatePropertiesChanged();
 
@@ -71,6 +73,8 @@ class BraveNewTabMessageHandler : public content::WebUIMessageHandler,
   void OnTorInitializing(const std::string& percentage) override;
 
   PrefChangeRegistrar pref_change_registrar_;
+  // Coalesces the stats pref changes made while pages block resources
+  base::OneShotTimer stats_update_timer_;
   // Weak pointer.
   Profile* profile_;
 #if BUILDFLAG(ENABLE_TOR)
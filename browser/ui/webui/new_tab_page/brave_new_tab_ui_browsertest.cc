@@ -6,11 +6,14 @@
 #include "base/path_service.h"
 #include "brave/browser/extensions/brave_extension_functional_test.h"
 #include "brave/common/brave_paths.h"
+#include "brave/common/pref_names.h"
+#include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/ui/browser.h"
 #include "chrome/browser/ui/tabs/tab_strip_model.h"
 #include "chrome/common/webui_url_constants.h"
 #include "chrome/test/base/in_process_browser_test.h"
 #include "chrome/test/base/ui_test_utils.h"
+#include "components/prefs/pref_service.h"
 #include "content/public/browser/child_process_termination_info.h"
 #include "content/public/browser/notification_service.h"
 #include "content/public/browser/notification_types.h"
@@ -106,3 +109,29 @@ IN_PROC_BROWSER_TEST_F(BraveNewTabUIBrowserTest, NewTabPageLocationOverride) {
       &inner_text));
   ASSERT_EQ("New tab override!", inner_text);
 }
+
+// Stats pref changes made while pages block resources should reach the page as
+// one update per burst.
+IN_PROC_BROWSER_TEST_F(BraveNewTabUIBrowserTest, StatsUpdatesAreCoalesced) {
+  auto* contents = browser()->tab_strip_model()->GetActiveWebContents();
+  GURL new_tab_url(chrome::kChromeUINewTabURL);
+  ui_test_utils::NavigateToURL(browser(), new_tab_url);
+  WaitForLoadStop(contents);
+
+  // Getting the stats allows javascript, which starts observing the prefs
+  ASSERT_EQ(true, EvalJs(contents,
+                         "window.statsUpdates = 0;"
+                         "cr.addWebUIListener('stats-updated',"
+                         "                    () => window.statsUpdates++);"
+                         "cr.sendWithPromise('getNewTabPageStats')"
+                         "    .then(() => true)"));
+
+  PrefService* prefs = browser()->profile()->GetPrefs();
+  for (int i = 0; i < 10; i++) {
+    prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
+  }
+
+  EXPECT_EQ(1, EvalJs(contents,
+                      "new Promise(resolve => setTimeout("
+                      "    () => resolve(window.statsUpdates), 1000))"));
+}
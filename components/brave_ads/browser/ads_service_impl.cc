@@ -58,6 +58,7 @@
 #include "brave/components/l10n/common/locale_util.h"
 #include "brave/components/rpill/common/rpill.h"
 #include "brave/components/services/bat_ads/public/cpp/ads_client_mojo_bridge.h"
+#include "brave/components/services/bat_ads/public/cpp/ads_database_mojo_bridge.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "brave/grit/brave_generated_resources.h"
 #include "chrome/browser/browser_process.h"
@@ -82,6 +83,7 @@
 #include "content/public/browser/network_service_instance.h"
 #include "content/public/browser/service_process_host.h"
 #include "content/public/browser/storage_partition.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "net/base/network_change_notifier.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
@@ -849,12 +851,24 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(const bool success) {
 
   BackgroundHelper::GetInstance()->AddObserver(this);
 
-  database_ = std::make_unique<ads::Database>(
+  // The database is bound and destroyed on |file_task_runner_|. Destruction is
+  // posted by |Shutdown| so it is ordered before any later reset of the files
+  if (database_) {
+    // Started twice, so a bind may still be pending for the previous database.
+    // |file_task_runner_| is sequenced, so deleting it there runs after that
+    file_task_runner_->DeleteSoon(FROM_HERE, database_.release());
+  }
+  database_ = std::make_unique<bat_ads::AdsDatabaseMojoBridge>(
       base_path_.AppendASCII("database.sqlite"));
+  mojo::PendingRemote<bat_ads::mojom::BatAdsDatabase> database;
+  file_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&bat_ads::AdsDatabaseMojoBridge::Bind,
+                                base::Unretained(database_.get()),
+                                database.InitWithNewPipeAndPassReceiver()));
 
   bat_ads_service_->Create(
       bat_ads_client_receiver_.BindNewEndpointAndPassRemote(),
-      bat_ads_.BindNewEndpointAndPassReceiver(),
+      bat_ads_.BindNewEndpointAndPassReceiver(), std::move(database),
       base::BindOnce(&AdsServiceImpl::OnCreate, AsWeakPtr()));
 
   OnWalletUpdated();
@@ -1978,34 +1992,13 @@ std::string AdsServiceImpl::LoadResourceForId(const std::string& id) {
   return LoadDataResourceAndDecompressIfNeeded(resource_id);
 }
 
-ads::DBCommandResponsePtr RunDBTransactionOnFileTaskRunner(
-    ads::DBTransactionPtr transaction,
-    ads::Database* database) {
-  DCHECK(database);
-
-  auto response = ads::DBCommandResponse::New();
-
-  if (!database) {
-    response->status = ads::DBCommandResponse::Status::RESPONSE_ERROR;
-  } else {
-    database->RunTransaction(std::move(transaction), response.get());
-  }
-
-  return response;
-}
-
 void AdsServiceImpl::RunDBTransaction(ads::DBTransactionPtr transaction,
                                       ads::RunDBTransactionCallback callback) {
-  base::PostTaskAndReplyWithResult(
-      file_task_runner_.get(), FROM_HERE,
-      base::BindOnce(&RunDBTransactionOnFileTaskRunner, std::move(transaction),
-                     database_.get()),
-      base::BindOnce(&AdsServiceImpl::OnRunDBTransaction, AsWeakPtr(),
-                     std::move(callback)));
-}
+  // Transactions no longer travel through BatAdsClient, see the header
+  NOTREACHED();
 
-void AdsServiceImpl::OnRunDBTransaction(ads::RunDBTransactionCallback callback,
-                                        ads::DBCommandResponsePtr response) {
+  auto response = ads::DBCommandResponse::New();
+  response->status = ads::DBCommandResponse::Status::RESPONSE_ERROR;
   callback(std::move(response));
 }
 
@@ -20,7 +20,6 @@
 #include "base/timer/timer.h"
 #include "bat/ads/ads.h"
 #include "bat/ads/ads_client.h"
-#include "bat/ads/database.h"
 #include "bat/ads/mojom.h"
 #include "bat/ledger/mojom_structs.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
@@ -50,6 +49,10 @@ namespace base {
 class SequencedTaskRunner;
 }  // namespace base
 
+namespace bat_ads {
+class AdsDatabaseMojoBridge;
+}  // namespace bat_ads
+
 namespace brave_rewards {
 class RewardsService;
 }  // namespace brave_rewards
@@ -277,9 +280,6 @@ class AdsServiceImpl : public AdsService,
   void OnLoaded(const ads::LoadCallback& callback, const std::string& value);
   void OnSaved(const ads::ResultCallback& callback, const bool success);
 
-  void OnRunDBTransaction(ads::RunDBTransactionCallback callback,
-                          ads::DBCommandResponsePtr response);
-
   void MigratePrefs();
   bool MigratePrefs(const int source_version,
                     const int dest_version,
@@ -354,6 +354,10 @@ class AdsServiceImpl : public AdsService,
 
   std::string LoadResourceForId(const std::string& id) override;
 
+  // Never called: the service sends transactions to |database_| directly, see
+  // |bat_ads::AdsDatabaseMojoBridge|. The override must remain because
+  // |ads::AdsClient| is shared with the library, where
+  // |BatAdsClientMojoBridge| implements it over the BatAdsDatabase pipe
   void RunDBTransaction(ads::DBTransactionPtr transaction,
                         ads::RunDBTransactionCallback callback) override;
 
@@ -425,7 +429,7 @@ class AdsServiceImpl : public AdsService,
 
   base::OneShotTimer onboarding_timer_;
 
-  std::unique_ptr<ads::Database> database_;
+  std::unique_ptr<bat_ads::AdsDatabaseMojoBridge> database_;
 
   ui::IdleState last_idle_state_;
   int last_idle_time_;
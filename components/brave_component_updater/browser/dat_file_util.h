@@ -8,10 +8,12 @@
 
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 
 namespace brave_component_updater {
 
@@ -21,26 +23,41 @@ void GetDATFileData(const base::FilePath& file_path,
                     DATFileDataBuffer* buffer);
 std::string GetDATFileAsString(const base::FilePath& file_path);
 
+// Maps |file_path| read-only. Returns nullptr if the file is missing, empty
+// or cannot be mapped
+std::unique_ptr<base::MemoryMappedFile> MapDATFile(
+    const base::FilePath& file_path);
+
+// Specialize as std::true_type for types whose |deserialize| keeps pointers
+// into the DAT file data instead of copying what it needs. The file then stays
+// mapped for as long as the caller keeps the |LoadDATFileDataResult| around
+template <typename T>
+struct DATFileDeserializesInPlace : std::false_type {};
+
 template<typename T>
 using LoadDATFileDataResult =
-    std::pair<std::unique_ptr<T>, brave_component_updater::DATFileDataBuffer>;
+    std::pair<std::unique_ptr<T>, std::unique_ptr<base::MemoryMappedFile>>;
 
+// Deserializes |dat_file_path| straight from a read-only mapping of the file,
+// rather than from a heap copy. The mapping is released once |T| has copied
+// what it needs, unless |T| deserializes in place
 template<typename T>
 LoadDATFileDataResult<T> LoadDATFileData(
     const base::FilePath& dat_file_path) {
-  DATFileDataBuffer buffer;
-  GetDATFileData(dat_file_path, &buffer);
-  std::unique_ptr<T> client;
-  client = std::make_unique<T>();
-  if (buffer.empty() ||
-      !client->deserialize(reinterpret_cast<char*>(&buffer.front()),
-          buffer.size()))
+  std::unique_ptr<base::MemoryMappedFile> dat_file = MapDATFile(dat_file_path);
+  if (!dat_file)
+    return LoadDATFileDataResult<T>();
+
+  std::unique_ptr<T> client = std::make_unique<T>();
+  if (!client->deserialize(reinterpret_cast<const char*>(dat_file->data()),
+                           dat_file->length()))
     client.reset();
 
-  return LoadDATFileDataResult<T>(
-      std::move(client), std::move(buffer));
-}
+  if (!client || !DATFileDeserializesInPlace<T>::value)
+    dat_file.reset();
 
+  return LoadDATFileDataResult<T>(std::move(client), std::move(dat_file));
+}
 
 }  // namespace brave_component_updater
 
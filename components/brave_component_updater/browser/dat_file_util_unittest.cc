@@ -0,0 +1,112 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_component_updater/browser/dat_file_util.h"
+
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_piece.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_component_updater {
+
+namespace {
+
+const char kDATFileContents[] = "brave dat file";
+
+// Copies the DAT file data, like the adblock and speedreader engines
+class CopyingClient {
+ public:
+  bool deserialize(const char* data, size_t data_size) {
+    data_.assign(data, data_size);
+    return data_ == kDATFileContents;
+  }
+
+  std::string data_;
+};
+
+// Keeps pointing into the DAT file data
+class InPlaceClient {
+ public:
+  bool deserialize(const char* data, size_t data_size) {
+    data_ = base::StringPiece(data, data_size);
+    return true;
+  }
+
+  base::StringPiece data_;
+};
+
+}  // namespace
+
+template <>
+struct DATFileDeserializesInPlace<InPlaceClient> : std::true_type {};
+
+class DATFileUtilTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    dat_file_path_ = temp_dir_.GetPath().AppendASCII("test.dat");
+  }
+
+  void WriteDATFile(const std::string& contents) {
+    ASSERT_EQ(static_cast<int>(contents.size()),
+              base::WriteFile(dat_file_path_, contents.data(),
+                              contents.size()));
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath dat_file_path_;
+};
+
+TEST_F(DATFileUtilTest, MissingFile) {
+  EXPECT_FALSE(MapDATFile(dat_file_path_));
+
+  const LoadDATFileDataResult<CopyingClient> result =
+      LoadDATFileData<CopyingClient>(dat_file_path_);
+  EXPECT_FALSE(result.first);
+  EXPECT_FALSE(result.second);
+}
+
+TEST_F(DATFileUtilTest, EmptyFile) {
+  WriteDATFile("");
+
+  EXPECT_FALSE(MapDATFile(dat_file_path_));
+  EXPECT_FALSE(LoadDATFileData<CopyingClient>(dat_file_path_).first);
+}
+
+TEST_F(DATFileUtilTest, ReleasesMappingAfterCopy) {
+  WriteDATFile(kDATFileContents);
+
+  const LoadDATFileDataResult<CopyingClient> result =
+      LoadDATFileData<CopyingClient>(dat_file_path_);
+  ASSERT_TRUE(result.first);
+  EXPECT_EQ(kDATFileContents, result.first->data_);
+  EXPECT_FALSE(result.second);
+}
+
+TEST_F(DATFileUtilTest, ReleasesMappingIfDeserializeFails) {
+  WriteDATFile("corrupted");
+
+  const LoadDATFileDataResult<CopyingClient> result =
+      LoadDATFileData<CopyingClient>(dat_file_path_);
+  EXPECT_FALSE(result.first);
+  EXPECT_FALSE(result.second);
+}
+
+TEST_F(DATFileUtilTest, KeepsMappingForInPlaceDeserialization) {
+  WriteDATFile(kDATFileContents);
+
+  const LoadDATFileDataResult<InPlaceClient> result =
+      LoadDATFileData<InPlaceClient>(dat_file_path_);
+  ASSERT_TRUE(result.first);
+  ASSERT_TRUE(result.second);
+  EXPECT_EQ(reinterpret_cast<const char*>(result.second->data()),
+            result.first->data_.data());
+  EXPECT_EQ(kDATFileContents, result.first->data_);
+}
+
+}  // namespace brave_component_updater
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_component_updater/browser/extension_whitelist_service.h"
 
+#include <memory>
 #include <utility>
 
 #include "base/bind.h"
@@ -18,6 +19,24 @@ using extensions::Extension;
 
 namespace brave_component_updater {
 
+namespace {
+
+ExtensionWhitelistService::GetDATFileDataResult LoadExtensionWhitelist(
+    const base::FilePath& dat_file_path) {
+  DATFileDataBuffer buffer;
+  GetDATFileData(dat_file_path, &buffer);
+  auto client = std::make_unique<ExtensionWhitelistParser>();
+  if (buffer.empty() ||
+      !client->deserialize(reinterpret_cast<char*>(&buffer.front()),
+                           buffer.size()))
+    client.reset();
+
+  return ExtensionWhitelistService::GetDATFileDataResult(std::move(client),
+                                                         std::move(buffer));
+}
+
+}  // namespace
+
 ExtensionWhitelistService::ExtensionWhitelistService(
     LocalDataFilesService* local_data_files_service,
     const std::vector<std::string>& whitelist)
@@ -68,9 +87,7 @@ void ExtensionWhitelistService::OnComponentReady(
   base::PostTaskAndReplyWithResult(
       local_data_files_service()->GetTaskRunner().get(),
       FROM_HERE,
-      base::BindOnce(
-          &brave_component_updater::LoadDATFileData<ExtensionWhitelistParser>,
-          dat_file_path),
+      base::BindOnce(&LoadExtensionWhitelist, dat_file_path),
       base::BindOnce(&ExtensionWhitelistService::OnGetDATFileData,
                      weak_factory_.GetWeakPtr()));
 }
@@ -31,8 +31,11 @@ namespace brave_component_updater {
 // The brave shields service in charge of extension whitelist
 class ExtensionWhitelistService : public LocalDataFilesObserver {
  public:
+  // The parser takes a mutable buffer and may keep pointers into it, so the
+  // DAT file is read into a heap buffer that lives as long as the parser
   using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<ExtensionWhitelistParser>;
+      std::pair<std::unique_ptr<ExtensionWhitelistParser>,
+                brave_component_updater::DATFileDataBuffer>;
 
   explicit ExtensionWhitelistService(
       LocalDataFilesService* local_data_files_service,
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -18,6 +19,26 @@ constexpr double kOutlierThreshold = 6;
 // if above 20MB _and_ more than 6x of the transfer size, probably an outlier
 constexpr double kSavingsAbsoluteOutlier = 20 << 20;
 
+// Returns the position of the feature |name| in |feature_sequence|, or
+// |feature_count| if the model doesn't use it. Intended to be evaluated at
+// compile time, so features can be accumulated straight into a vector.
+constexpr size_t FeatureIndex(const char* name) {
+  for (size_t i = 0; i < feature_count; i++) {
+    const char* feature = feature_sequence[i];
+    size_t j = 0;
+    while (feature[j] != '\0' && feature[j] == name[j])
+      j++;
+    if (feature[j] == name[j])
+      return i;
+  }
+  return feature_count;
+}
+
+// Returns the position of the "thirdParties.<entity>.blocked" feature for
+// |entity| in |feature_sequence|, or |feature_count| if the model doesn't use
+// it.
+size_t ThirdPartyBlockedFeatureIndex(base::StringPiece entity);
+
 // Computes prediction based on the provided feature vector.
 // It is the client's responsibility to provide features in
 // the exact order expected by the predictor.
@@ -8,12 +8,8 @@
 
 /* This file is automatically generated, do not edit directly */
 
-#include <string>
 #include <array>
 
-#include "base/containers/flat_set.h"
-#include "base/containers/flat_map.h"
-
 namespace brave_perf_predictor {
 
 constexpr double model_intercept = 5.085407773814489;
@@ -288,7 +284,7 @@ constexpr std::array<double, standardise_feat_count> standardise_feat_scale = {
 3333644.900695055
 };
 
-const std::array<std::string, feature_count> feature_sequence{
+constexpr std::array<const char*, feature_count> feature_sequence{
     "adblockRequests",
     "metrics.firstMeaningfulPaint",
     "metrics.observedDomContentLoaded",
@@ -504,7 +500,7 @@ const std::array<std::string, feature_count> feature_sequence{
     "thirdParties.Yandex APIs.blocked",
 };
 
-const std::array<std::string, 190> relevant_entities{
+constexpr std::array<const char*, 190> relevant_entities{
   "Google Analytics",
   "Facebook",
   "Google CDN",
@@ -697,109 +693,6 @@ const std::array<std::string, 190> relevant_entities{
   "Yandex APIs",
 };
 
-const base::flat_set<std::string> relevant_entity_set(
-    relevant_entities.begin(),
-    relevant_entities.end());
-
-struct stdfactor {
-  double mean, scale;
-};
-
-const base::flat_map<std::string, stdfactor> stdfactor_map = {
-  {
-    "adblockRequests",
-    { 11.155786350148368, 12.073811227476089 }
-  },
-  {
-    "metrics.firstMeaningfulPaint",
-    { 1016.2856083086053, 926.9436100765363 }
-  },
-  {
-    "metrics.observedDomContentLoaded",
-    { 1181.3004451038576, 979.2250013928962 }
-  },
-  {
-    "metrics.observedFirstVisualChange",
-    { 717.0712166172107, 779.8742124298378 }
-  },
-  {
-    "metrics.observedLoad",
-    { 1987.0066765578636, 1919.1239982290276 }
-  },
-  {
-    "resources.document.requestCount",
-    { 2.4109792284866467, 2.102760215714359 }
-  },
-  {
-    "resources.document.size",
-    { 61992.13946587537, 87820.15974403986 }
-  },
-  {
-    "resources.font.requestCount",
-    { 4.561572700296736, 3.575166724949133 }
-  },
-  {
-    "resources.font.size",
-    { 149840.9243323442, 280657.60316361417 }
-  },
-  {
-    "resources.image.requestCount",
-    { 35.32047477744807, 36.691628938982134 }
-  },
-  {
-    "resources.image.size",
-    { 955033.309347181, 2053276.1547853663 }
-  },
-  {
-    "resources.media.requestCount",
-    { 0.13427299703264095, 3.22967240113416 }
-  },
-  {
-    "resources.media.size",
-    { 15261.759643916914, 205275.94312591644 }
-  },
-  {
-    "resources.other.requestCount",
-    { 8.208456973293769, 14.301294363369117 }
-  },
-  {
-    "resources.other.size",
-    { 246940.89243323443, 2396278.961167811 }
-  },
-  {
-    "resources.script.requestCount",
-    { 23.16765578635015, 24.39484351361213 }
-  },
-  {
-    "resources.script.size",
-    { 495043.6083086053, 432881.54561501107 }
-  },
-  {
-    "resources.stylesheet.requestCount",
-    { 6.2974777448071215, 10.733199259238853 }
-  },
-  {
-    "resources.stylesheet.size",
-    { 103430.64317507419, 129287.31378334873 }
-  },
-  {
-    "resources.third-party.requestCount",
-    { 48.926557863501486, 52.84516132149959 }
-  },
-  {
-    "resources.third-party.size",
-    { 974124.4658753709, 2258334.3952942668 }
-  },
-  {
-    "resources.total.requestCount",
-    { 80.10089020771514, 57.77650764802925 }
-  },
-  {
-    "resources.total.size",
-    { 2027543.2767062315, 3333644.900695055 }
-  },
-};
-
 }  // namespace brave_perf_predictor
 
 #endif  // BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_PARAMETERS_H_
@@ -104,4 +104,22 @@ TEST(BraveSavingsPredictorTest, HandesSpecificFeaturemapExample) {
             794);  // Equal on the order of thousands
 }
 
+TEST(BraveSavingsPredictorTest, FindsFeatureIndices) {
+  static_assert(FeatureIndex("adblockRequests") == 0,
+                "Feature indices are resolved at compile time");
+  EXPECT_EQ(FeatureIndex("unknown"), static_cast<size_t>(feature_count));
+  for (size_t i = 0; i < feature_count; i++) {
+    EXPECT_EQ(FeatureIndex(feature_sequence[i]), i);
+  }
+}
+
+TEST(BraveSavingsPredictorTest, FindsThirdPartyBlockedFeatureIndices) {
+  EXPECT_EQ(ThirdPartyBlockedFeatureIndex("Google Analytics"),
+            FeatureIndex("thirdParties.Google Analytics.blocked"));
+  EXPECT_EQ(ThirdPartyBlockedFeatureIndex("Unknown Entity"),
+            static_cast<size_t>(feature_count));
+  EXPECT_EQ(ThirdPartyBlockedFeatureIndex(""),
+            static_cast<size_t>(feature_count));
+}
+
 }  // namespace brave_perf_predictor
@@ -11,6 +11,7 @@
 #include "base/run_loop.h"
 #include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "chrome/browser/predictors/loading_test_util.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "components/page_load_metrics/common/page_load_timing.h"
@@ -32,6 +33,13 @@ class BandwidthSavingsPredictorTest : public ::testing::Test {
   }
 
  protected:
+  double GetFeature(const char* name) {
+    const size_t index = FeatureIndex(name);
+    if (index >= feature_count)
+      return 0;
+    return predictor_->features_[index];
+  }
+
   base::test::TaskEnvironment env_;
   std::unique_ptr<NamedThirdPartyRegistry> tp_registry_;
   std::unique_ptr<BandwidthSavingsPredictor> predictor_;
@@ -39,45 +47,44 @@ class BandwidthSavingsPredictorTest : public ::testing::Test {
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseBlocked) {
   predictor_->OnSubresourceBlocked("https://google-analytics.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 1);
-  EXPECT_EQ(predictor_->feature_map_["thirdParties.Google Analytics.blocked"],
-            1);
+  EXPECT_EQ(GetFeature("adblockRequests"), 1);
+  EXPECT_EQ(GetFeature("thirdParties.Google Analytics.blocked"), 1);
   predictor_->OnSubresourceBlocked("https://test.m.facebook.com");
-  EXPECT_EQ(predictor_->feature_map_["adblockRequests"], 2);
+  EXPECT_EQ(GetFeature("adblockRequests"), 2);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseTiming) {
   const auto empty_timing = page_load_metrics::CreatePageLoadTiming();
   predictor_->OnPageLoadTimingUpdated(*empty_timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 0);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 0);
+  EXPECT_EQ(GetFeature("metrics.firstMeaningfulPaint"), 0);
+  EXPECT_EQ(GetFeature("metrics.observedDomContentLoaded"), 0);
+  EXPECT_EQ(GetFeature("metrics.observedFirstVisualChange"), 0);
+  EXPECT_EQ(GetFeature("metrics.observedLoad"), 0);
 
   auto timing = page_load_metrics::CreatePageLoadTiming();
   timing->document_timing->dom_content_loaded_event_start =
       base::TimeDelta::FromMilliseconds(1000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedDomContentLoaded"], 1000);
+  EXPECT_EQ(GetFeature("metrics.observedDomContentLoaded"), 1000);
 
   timing->document_timing->load_event_start =
       base::TimeDelta::FromMilliseconds(2000);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedLoad"], 2000);
+  EXPECT_EQ(GetFeature("metrics.observedLoad"), 2000);
 
   timing->paint_timing->first_meaningful_paint =
       base::TimeDelta::FromMilliseconds(1500);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.firstMeaningfulPaint"], 1500);
+  EXPECT_EQ(GetFeature("metrics.firstMeaningfulPaint"), 1500);
 
   timing->paint_timing->first_contentful_paint =
       base::TimeDelta::FromMilliseconds(800);
   predictor_->OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor_->feature_map_["metrics.observedFirstVisualChange"], 800);
+  EXPECT_EQ(GetFeature("metrics.observedFirstVisualChange"), 800);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
+  EXPECT_EQ(GetFeature("resources.third-party.requestCount"), 0);
 
   const GURL main_frame("https://brave.com/");
 
@@ -86,9 +93,9 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
       network::mojom::RequestDestination::kStyle);
   fp_style->raw_body_bytes = 1000;
   predictor_->OnResourceLoadComplete(main_frame, *fp_style);
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 0);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
+  EXPECT_EQ(GetFeature("resources.third-party.requestCount"), 0);
+  EXPECT_EQ(GetFeature("resources.stylesheet.requestCount"), 1);
+  EXPECT_EQ(GetFeature("resources.stylesheet.size"), 1000);
 
   auto tp_style = predictors::CreateResourceLoadInfo(
       "https://stackpath.bootstrapcdn.com/bootstrap/4.4.1/css/bootstrap.min.js",
@@ -96,14 +103,14 @@ TEST_F(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
   tp_style->raw_body_bytes = 1001;
   predictor_->OnResourceLoadComplete(main_frame, *tp_style);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.third-party.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.requestCount"], 1);
-  EXPECT_EQ(predictor_->feature_map_["resources.stylesheet.size"], 1000);
-  EXPECT_EQ(predictor_->feature_map_["resources.script.size"], 1001);
+  EXPECT_EQ(GetFeature("resources.third-party.requestCount"), 1);
+  EXPECT_EQ(GetFeature("resources.stylesheet.requestCount"), 1);
+  EXPECT_EQ(GetFeature("resources.script.requestCount"), 1);
+  EXPECT_EQ(GetFeature("resources.stylesheet.size"), 1000);
+  EXPECT_EQ(GetFeature("resources.script.size"), 1001);
 
-  EXPECT_EQ(predictor_->feature_map_["resources.total.requestCount"], 2);
-  EXPECT_EQ(predictor_->feature_map_["resources.total.size"], 2001);
+  EXPECT_EQ(GetFeature("resources.total.requestCount"), 2);
+  EXPECT_EQ(GetFeature("resources.total.size"), 2001);
 }
 
 TEST_F(BandwidthSavingsPredictorTest, PredictZeroNoData) {
@@ -160,4 +167,67 @@ TEST_F(BandwidthSavingsPredictorTest, PredictNonZero) {
   EXPECT_NE(predictor_->PredictSavingsBytes(), 0);
 }
 
+TEST_F(BandwidthSavingsPredictorTest, PredictionMatchesNamedFeatures) {
+  const GURL main_frame("https://brave.com");
+  base::flat_map<std::string, double> feature_map;
+
+  auto document = predictors::CreateResourceLoadInfo(
+      "https://brave.com/", network::mojom::RequestDestination::kDocument);
+  document->raw_body_bytes = 30000;
+  document->total_received_bytes = 31000;
+  predictor_->OnResourceLoadComplete(main_frame, *document);
+  feature_map["resources.document.requestCount"] += 1;
+  feature_map["resources.document.size"] += 30000;
+
+  auto image = predictors::CreateResourceLoadInfo(
+      "https://cdn.example.com/hero.jpg",
+      network::mojom::RequestDestination::kImage);
+  image->raw_body_bytes = 150000;
+  image->total_received_bytes = 151000;
+  for (int i = 0; i < 10; i++) {
+    predictor_->OnResourceLoadComplete(main_frame, *image);
+    feature_map["resources.image.requestCount"] += 1;
+    feature_map["resources.image.size"] += 150000;
+    feature_map["resources.third-party.requestCount"] += 1;
+    feature_map["resources.third-party.size"] += 150000;
+  }
+
+  predictor_->OnSubresourceBlocked("https://google-analytics.com/ga.js");
+  predictor_->OnSubresourceBlocked("https://example.com/ad.js");
+  feature_map["adblockRequests"] = 2;
+  feature_map["thirdParties.Google Analytics.blocked"] = 1;
+
+  auto timing = page_load_metrics::CreatePageLoadTiming();
+  timing->document_timing->dom_content_loaded_event_start =
+      base::TimeDelta::FromMilliseconds(900);
+  timing->document_timing->load_event_start =
+      base::TimeDelta::FromMilliseconds(1800);
+  predictor_->OnPageLoadTimingUpdated(*timing);
+  feature_map["metrics.observedDomContentLoaded"] = 900;
+  feature_map["metrics.observedLoad"] = 1800;
+
+  feature_map["resources.total.requestCount"] = 11;
+  feature_map["resources.total.size"] = 1530000;
+
+  EXPECT_EQ(GetFeature("thirdParties.Google Analytics.blocked"), 1);
+  EXPECT_DOUBLE_EQ(predictor_->PredictSavingsBytes(),
+                   LinregPredictNamed(feature_map));
+}
+
+TEST_F(BandwidthSavingsPredictorTest, ResetClearsFeatures) {
+  const GURL main_frame("https://brave.com");
+  auto res = predictors::CreateResourceLoadInfo(
+      "https://brave.com/style.css",
+      network::mojom::RequestDestination::kStyle);
+  res->raw_body_bytes = 1000;
+  predictor_->OnResourceLoadComplete(main_frame, *res);
+  predictor_->OnSubresourceBlocked("https://google-analytics.com/ga.js");
+
+  predictor_->Reset();
+  EXPECT_EQ(GetFeature("adblockRequests"), 0);
+  EXPECT_EQ(GetFeature("thirdParties.Google Analytics.blocked"), 0);
+  EXPECT_EQ(GetFeature("resources.stylesheet.size"), 0);
+  EXPECT_EQ(predictor_->PredictSavingsBytes(), 0);
+}
+
 }  // namespace brave_perf_predictor
@@ -6,11 +6,13 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 
+#include <functional>
 #include <string>
-#include <tuple>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
+#include "base/strings/string_piece.h"
 #include "base/values.h"
 #include "components/keyed_service/core/keyed_service.h"
 
@@ -33,19 +35,31 @@ class NamedThirdPartyRegistry : public KeyedService {
   bool LoadMappings(const base::StringPiece entities, bool discard_irrelevant);
   // Default initialization - asynchronously load from bundled resource
   void InitializeDefault();
-  base::Optional<std::string> GetThirdParty(
+  // The returned name is owned by the registry and is only valid until the
+  // mappings are next loaded
+  base::Optional<base::StringPiece> GetThirdParty(
       const base::StringPiece domain) const;
 
+  // Entity names are stored once in |entities|, and domains map to the index
+  // of their entity instead of holding a copy of its name
+  struct EntityMappings {
+    EntityMappings();
+    EntityMappings(EntityMappings&& other);
+    EntityMappings& operator=(EntityMappings&& other);
+    ~EntityMappings();
+
+    std::vector<std::string> entities;
+    base::flat_map<std::string, size_t, std::less<>> entity_by_domain;
+    base::flat_map<std::string, size_t, std::less<>> entity_by_root_domain;
+  };
+
  private:
   bool IsInitialized() const { return initialized_; }
   void MarkInitialized(bool initialized) { initialized_ = initialized; }
-  void UpdateMappings(
-      std::tuple<base::flat_map<std::string, std::string>,
-                 base::flat_map<std::string, std::string>> entity_mappings);
+  void UpdateMappings(EntityMappings entity_mappings);
 
   bool initialized_ = false;
-  base::flat_map<std::string, std::string> entity_by_domain_;
-  base::flat_map<std::string, std::string> entity_by_root_domain_;
+  EntityMappings mappings_;
 
   base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
 };
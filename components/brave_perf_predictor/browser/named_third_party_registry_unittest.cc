@@ -111,6 +111,17 @@ TEST(NamedThirdPartyRegistryTest, ExtractsThirdPartyRootDomainTest) {
   EXPECT_EQ(entity.value(), "Facebook");
 }
 
+TEST(NamedThirdPartyRegistryTest, SharesEntityNamesBetweenDomains) {
+  NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
+  extractor->LoadMappings(test_mapping, false);
+  auto entity = extractor->GetThirdParty("https://www.facebook.com");
+  auto other_entity = extractor->GetThirdParty("https://connect.facebook.net");
+  ASSERT_TRUE(entity.has_value());
+  ASSERT_TRUE(other_entity.has_value());
+  EXPECT_EQ(entity.value(), "Facebook");
+  EXPECT_EQ(entity->data(), other_entity->data());
+}
+
 TEST(NamedThirdPartyRegistryTest, HandlesUnrecognisedThirdPartyTest) {
   NamedThirdPartyRegistry* extractor = new NamedThirdPartyRegistry();
   auto dataset = LoadFile();
@@ -8,12 +8,8 @@
 
 /* This file is automatically generated, do not edit directly */
 
-#include <string>
 #include <array>
 
-#include "base/containers/flat_set.h"
-#include "base/containers/flat_map.h"
-
 namespace brave_perf_predictor {
 
 constexpr double model_intercept = {{model.intercept}};
@@ -32,7 +28,7 @@ constexpr std::array<double, standardise_feat_count> standardise_feat_scale = {
 {{transformers.standardise.scale | join(',\n')}}
 };
 
-const std::array<std::string, feature_count> feature_sequence{
+constexpr std::array<const char*, feature_count> feature_sequence{
     {% for feature in transformers.standardise.features %}
     "{{feature}}",
     {% endfor %}
@@ -41,29 +37,12 @@ const std::array<std::string, feature_count> feature_sequence{
     {% endfor %}
 };
 
-const std::array<std::string, {{misc.entities | length}}> relevant_entities{
+constexpr std::array<const char*, {{misc.entities | length}}> relevant_entities{
   {% for entity in misc.entities %}
   "{{entity}}",
   {% endfor %}
 };
 
-const base::flat_set<std::string> relevant_entity_set(
-    relevant_entities.begin(),
-    relevant_entities.end());
-
-struct stdfactor {
-  double mean, scale;
-};
-
-const base::flat_map<std::string, stdfactor> stdfactor_map = {
-  {% for feature, (mean, scale) in transformers.standardise.feature_map %}
-  {
-    "{{feature}}",
-    { {{mean}}, {{scale}} }
-  },
-  {% endfor %}
-};
-
 }  // namespace brave_perf_predictor
 
 #endif  // BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_PARAMETERS_H_
@@ -52,11 +52,6 @@ class BraveReferralsService : public ProfileManagerObserver {
 
   static void SetPromoFilePathForTesting(const base::FilePath& path);
 
-  static bool GetMatchingReferralHeaders(
-      const base::ListValue& referral_headers_list,
-      const base::DictionaryValue** request_headers_dict,
-      const GURL& url);
-
   static bool IsDefaultReferralCode(const std::string& code);
 
  private:
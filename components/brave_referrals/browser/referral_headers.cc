@@ -0,0 +1,117 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_referrals/browser/referral_headers.h"
+
+#include <map>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "url/url_constants.h"
+
+namespace brave {
+
+namespace {
+
+const size_t kNoMatch = static_cast<size_t>(-1);
+
+}  // namespace
+
+ReferralHeaders::ReferralHeaders() = default;
+
+ReferralHeaders::~ReferralHeaders() = default;
+
+// static
+std::unique_ptr<ReferralHeaders> ReferralHeaders::FromValue(
+    const base::Value& value) {
+  auto referral_headers = std::make_unique<ReferralHeaders>();
+  if (!value.is_list()) {
+    return referral_headers;
+  }
+
+  std::map<std::string, size_t> domains;
+  for (const auto& headers_value : value.GetList()) {
+    const base::Value* domains_list =
+        headers_value.FindKeyOfType("domains", base::Value::Type::LIST);
+    if (!domains_list) {
+      LOG(WARNING) << "Failed to retrieve 'domains' key from referral headers";
+      continue;
+    }
+
+    const base::Value* headers_dict =
+        headers_value.FindKeyOfType("headers", base::Value::Type::DICTIONARY);
+    if (!headers_dict) {
+      LOG(WARNING) << "Failed to retrieve 'headers' key from referral headers";
+      continue;
+    }
+
+    Headers headers;
+    for (const auto& header : headers_dict->DictItems()) {
+      if (!header.second.is_string()) {
+        LOG(WARNING) << "Invalid value for referral header " << header.first;
+        continue;
+      }
+
+      headers[header.first] = header.second.GetString();
+    }
+
+    const size_t index = referral_headers->headers_.size();
+    referral_headers->headers_.push_back(std::move(headers));
+
+    for (const auto& domain_value : domains_list->GetList()) {
+      if (!domain_value.is_string()) {
+        continue;
+      }
+
+      // Earlier entries take precedence
+      domains.emplace(domain_value.GetString(), index);
+    }
+  }
+
+  referral_headers->domains_ =
+      base::flat_map<std::string, size_t, std::less<>>(domains.begin(),
+                                                       domains.end());
+
+  return referral_headers;
+}
+
+const ReferralHeaders::Headers* ReferralHeaders::GetMatchingHeaders(
+    const GURL& url) const {
+  if (domains_.empty() || !url.SchemeIsHTTPOrHTTPS()) {
+    return nullptr;
+  }
+
+  // Domains match themselves and their subdomains, so check the host and each
+  // of its parent domains, i.e. "www.example.com", "example.com" and "com"
+  size_t best = kNoMatch;
+  base::StringPiece host = url.host_piece();
+  while (true) {
+    const auto iter = domains_.find(host);
+    if (iter != domains_.end() && iter->second < best) {
+      best = iter->second;
+    }
+
+    if (host.empty()) {
+      break;
+    }
+
+    const size_t pos = host.find('.');
+    host = pos == base::StringPiece::npos ? base::StringPiece()
+                                          : host.substr(pos + 1);
+  }
+
+  if (best == kNoMatch) {
+    return nullptr;
+  }
+
+  return &headers_[best];
+}
+
+bool ReferralHeaders::empty() const {
+  return domains_.empty();
+}
+
+}  // namespace brave
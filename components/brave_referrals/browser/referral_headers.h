@@ -0,0 +1,54 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_H_
+#define BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/values.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+// Referral header rules parsed from the |kReferralHeaders| pref. Domains are
+// indexed so that finding the headers for a request is a lookup per label of
+// the request host, instead of walking the pref list and building a
+// URLPattern for every domain. Instances are immutable, so a new instance is
+// created and swapped in whenever the pref changes.
+class ReferralHeaders {
+ public:
+  using Headers = base::flat_map<std::string, std::string>;
+
+  ReferralHeaders();
+  ~ReferralHeaders();
+
+  ReferralHeaders(const ReferralHeaders&) = delete;
+  ReferralHeaders& operator=(const ReferralHeaders&) = delete;
+
+  // Parses a list of {"domains": [...], "headers": {...}} dictionaries.
+  // Malformed entries are skipped
+  static std::unique_ptr<ReferralHeaders> FromValue(const base::Value& value);
+
+  // Returns the headers of the first entry with a domain matching the host of
+  // |url| or one of its parent domains, or nullptr if there is no match
+  const Headers* GetMatchingHeaders(const GURL& url) const;
+
+  bool empty() const;
+
+ private:
+  std::vector<Headers> headers_;
+
+  // Index into |headers_| of the first entry listing each domain
+  base::flat_map<std::string, size_t, std::less<>> domains_;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_H_
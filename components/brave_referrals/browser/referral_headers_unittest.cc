@@ -0,0 +1,152 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_referrals/browser/referral_headers.h"
+
+#include <memory>
+#include <string>
+
+#include "base/json/json_reader.h"
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+const char kTestReferralHeaders[] = R"(
+  [
+    {
+      "domains": [
+         "marketwatch.com",
+         "barrons.com"
+      ],
+      "headers": {
+         "X-Brave-Partner": "dowjones",
+         "X-Invalid": 1
+      },
+      "cookieNames": [
+      ],
+      "expiration": 31536000000
+    },
+    {
+      "domains": [
+         "townsquareblogs.com"
+      ]
+    },
+    {
+      "domains": [
+         "townsquareblogs.com",
+         "www.marketwatch.com",
+         "tasteofcountry.com"
+      ],
+      "headers": {
+         "X-Brave-Partner": "townsquare"
+      }
+    }
+  ])";
+
+std::unique_ptr<ReferralHeaders> ParseReferralHeaders(const std::string& json) {
+  const base::Optional<base::Value> value = base::JSONReader::Read(json);
+  EXPECT_TRUE(value);
+  return ReferralHeaders::FromValue(*value);
+}
+
+std::string GetPartnerHeader(const ReferralHeaders& referral_headers,
+                             const std::string& url) {
+  const ReferralHeaders::Headers* headers =
+      referral_headers.GetMatchingHeaders(GURL(url));
+  if (!headers) {
+    return std::string();
+  }
+
+  const auto iter = headers->find("X-Brave-Partner");
+  if (iter == headers->end()) {
+    return std::string();
+  }
+
+  return iter->second;
+}
+
+}  // namespace
+
+TEST(BraveReferralHeadersTest, EmptyList) {
+  const std::unique_ptr<ReferralHeaders> referral_headers =
+      ParseReferralHeaders("[]");
+  EXPECT_TRUE(referral_headers->empty());
+  EXPECT_FALSE(referral_headers->GetMatchingHeaders(GURL("https://a.com")));
+}
+
+TEST(BraveReferralHeadersTest, NotAList) {
+  const std::unique_ptr<ReferralHeaders> referral_headers =
+      ParseReferralHeaders(R"({"domains": ["a.com"]})");
+  EXPECT_TRUE(referral_headers->empty());
+}
+
+TEST(BraveReferralHeadersTest, MatchesDomainAndSubdomains) {
+  const std::unique_ptr<ReferralHeaders> referral_headers =
+      ParseReferralHeaders(kTestReferralHeaders);
+  EXPECT_EQ("dowjones",
+            GetPartnerHeader(*referral_headers, "https://barrons.com/"));
+  EXPECT_EQ("dowjones",
+            GetPartnerHeader(*referral_headers, "http://a.b.barrons.com/x"));
+  EXPECT_EQ("", GetPartnerHeader(*referral_headers, "https://notbarrons.com"));
+  EXPECT_EQ("", GetPartnerHeader(*referral_headers, "https://barrons.com.au"));
+  EXPECT_EQ("", GetPartnerHeader(*referral_headers, "https://www.google.com"));
+}
+
+TEST(BraveReferralHeadersTest, IgnoresNonHttpSchemes) {
+  const std::unique_ptr<ReferralHeaders> referral_headers =
+      ParseReferralHeaders(kTestReferralHeaders);
+  EXPECT_EQ("", GetPartnerHeader(*referral_headers, "ftp://barrons.com/"));
+  EXPECT_EQ("", GetPartnerHeader(*referral_headers, "wss://barrons.com/"));
+}
+
+TEST(BraveReferralHeadersTest, FirstMatchingEntryWins) {
+  const std::unique_ptr<ReferralHeaders> referral_headers =
+      ParseReferralHeaders(kTestReferralHeaders);
+
+  // Listed by both the first and the last entry
+  EXPECT_EQ("dowjones",
+            GetPartnerHeader(*referral_headers, "https://www.marketwatch.com"));
+}
+
+TEST(BraveReferralHeadersTest, SkipsMalformedEntries) {
+  const std::unique_ptr<ReferralHeaders> referral_headers =
+      ParseReferralHeaders(kTestReferralHeaders);
+
+  // The second entry has no headers, so the third one applies
+  EXPECT_EQ("townsquare",
+            GetPartnerHeader(*referral_headers, "https://townsquareblogs.com"));
+
+  const ReferralHeaders::Headers* headers =
+      referral_headers->GetMatchingHeaders(GURL("https://barrons.com"));
+  ASSERT_TRUE(headers);
+  EXPECT_EQ(1u, headers->size());
+}
+
+TEST(BraveReferralHeadersTest, ManyDomains) {
+  std::string json = R"([{"domains": [)";
+  for (int i = 0; i < 10000; i++) {
+    if (i > 0) {
+      json += ",";
+    }
+    json += "\"partner" + base::NumberToString(i) + ".com\"";
+  }
+  json += R"(], "headers": {"X-Brave-Partner": "partner"}}])";
+
+  const std::unique_ptr<ReferralHeaders> referral_headers =
+      ParseReferralHeaders(json);
+
+  for (int i = 0; i < 10000; i += 101) {
+    const std::string host = "partner" + base::NumberToString(i) + ".com";
+    EXPECT_EQ("partner",
+              GetPartnerHeader(*referral_headers, "https://www." + host));
+    EXPECT_EQ("", GetPartnerHeader(*referral_headers, "https://x" + host));
+  }
+}
+
+}  // namespace brave
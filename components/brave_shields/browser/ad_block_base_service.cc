@@ -100,10 +100,40 @@ std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
   return filter_option;
 }
 
+// Loads the engine serialized in |dat_file_path| and applies |tags| and
+// |resources| to it, so that the engine is ready to match requests as soon
+// as it is installed
+brave_shields::AdBlockBaseService::GetDATFileDataResult LoadAdBlockClient(
+    const base::FilePath& dat_file_path,
+    const std::vector<std::string>& tags,
+    const std::string& resources) {
+  auto result =
+      brave_component_updater::LoadDATFileData<adblock::Engine>(dat_file_path);
+  if (!result.first) {
+    return result;
+  }
+
+  for (const auto& tag : tags) {
+    result.first->addTag(tag);
+  }
+  result.first->addResources(resources);
+
+  return result;
+}
+
 }  // namespace
 
 namespace brave_shields {
 
+AdBlockBaseService::ClientConfig::ClientConfig() = default;
+
+AdBlockBaseService::ClientConfig::ClientConfig(ClientConfig&& other) = default;
+
+AdBlockBaseService::ClientConfig& AdBlockBaseService::ClientConfig::operator=(
+    ClientConfig&& other) = default;
+
+AdBlockBaseService::ClientConfig::~ClientConfig() = default;
+
 AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
       ad_block_client_(new adblock::Engine()),
@@ -160,6 +190,7 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
       tags_.erase(it);
     }
   }
+  config_version_++;
 }
 
 void AdBlockBaseService::AddResources(const std::string& resources) {
@@ -172,6 +203,7 @@ void AdBlockBaseService::AddResources(const std::string& resources) {
 
   ad_block_client_->addResources(resources);
   resources_ = resources;
+  config_version_++;
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
@@ -194,35 +226,76 @@ base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
 }
 
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
+  // Take the current tags and resources from the task runner first, so the
+  // new engine can be fully prepared on the thread pool. Installing it is
+  // then a pointer swap, and requests matched on the task runner don't queue
+  // up behind the tags and resources being applied.
+  GetTaskRunner()->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&AdBlockBaseService::GetClientConfig,
+                     base::Unretained(this)),
+      base::BindOnce(&AdBlockBaseService::OnGetClientConfig,
+                     weak_factory_.GetWeakPtr(), dat_file_path));
+}
+
+AdBlockBaseService::ClientConfig AdBlockBaseService::GetClientConfig() {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  ClientConfig config;
+  config.tags = tags_;
+  config.resources = resources_;
+  config.version = config_version_;
+  return config;
+}
+
+void AdBlockBaseService::OnGetClientConfig(const base::FilePath& dat_file_path,
+                                           ClientConfig config) {
+  // Only the tags are needed again once the engine is loaded
+  std::vector<std::string> tags = config.tags;
+  std::string resources = std::move(config.resources);
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
-      base::BindOnce(&brave_component_updater::LoadDATFileData<adblock::Engine>,
-                     dat_file_path),
+      base::BindOnce(&LoadAdBlockClient, dat_file_path, std::move(tags),
+                     std::move(resources)),
       base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
-                     weak_factory_.GetWeakPtr()));
+                     weak_factory_.GetWeakPtr(), std::move(config)));
 }
 
-void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
-  if (result.second.empty()) {
-    LOG(ERROR) << "Could not obtain ad block data";
-    return;
-  }
+void AdBlockBaseService::OnGetDATFileData(ClientConfig config,
+                                          GetDATFileDataResult result) {
   if (!result.first.get()) {
-    LOG(ERROR) << "Failed to deserialize ad block data";
+    LOG(ERROR) << "Could not obtain or deserialize ad block data";
     return;
   }
   GetTaskRunner()->PostTask(
       FROM_HERE, base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
-                                base::Unretained(this),
+                                base::Unretained(this), std::move(config),
                                 std::move(result.first)));
 }
 
 void AdBlockBaseService::UpdateAdBlockClient(
+    ClientConfig config,
     std::unique_ptr<adblock::Engine> ad_block_client) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  std::unique_ptr<adblock::Engine> old_ad_block_client =
+      std::move(ad_block_client_);
   ad_block_client_ = std::move(ad_block_client);
-  AddKnownTagsToAdBlockInstance();
-  AddKnownResourcesToAdBlockInstance();
+
+  // Tags or resources changed while the engine was being prepared
+  if (config.version != config_version_) {
+    for (const auto& tag : config.tags) {
+      if (!TagExists(tag)) {
+        ad_block_client_->removeTag(tag);
+      }
+    }
+    AddKnownTagsToAdBlockInstance();
+    AddKnownResourcesToAdBlockInstance();
+  }
+
+  // Freeing a large engine takes a while, so don't do it on the task runner
+  base::PostTask(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::BEST_EFFORT},
+      base::BindOnce([](std::unique_ptr<adblock::Engine> ad_block_client) {},
+                     std::move(old_ad_block_client)));
 }
 
 void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
@@ -70,13 +70,32 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   std::unique_ptr<adblock::Engine> ad_block_client_;
 
  private:
+  // Tags and resources to apply to a new engine while it is prepared on the
+  // thread pool, along with the |config_version_| they were taken at
+  struct ClientConfig {
+    ClientConfig();
+    ClientConfig(ClientConfig&& other);
+    ClientConfig& operator=(ClientConfig&& other);
+    ~ClientConfig();
+
+    std::vector<std::string> tags;
+    std::string resources;
+    uint64_t version = 0;
+  };
+
+  ClientConfig GetClientConfig();
+  void OnGetClientConfig(const base::FilePath& dat_file_path,
+                         ClientConfig config);
   void UpdateAdBlockClient(
+      ClientConfig config,
       std::unique_ptr<adblock::Engine> ad_block_client);
-  void OnGetDATFileData(GetDATFileDataResult result);
+  void OnGetDATFileData(ClientConfig config, GetDATFileDataResult result);
   void OnPreferenceChanges(const std::string& pref_name);
 
   std::vector<std::string> tags_;
   std::string resources_;
+  // Bumped whenever |tags_| or |resources_| change on the task runner
+  uint64_t config_version_ = 0;
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
 };
@@ -11,10 +11,12 @@
 #include <utility>
 #include <vector>
 
+#include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/render_messages.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/frame_tab_origin_registry.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/content/common/frame_messages.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
@@ -98,38 +100,16 @@ WebContents* GetWebContents(
   return web_contents;
 }
 
+brave_shields::FrameTabOriginRegistry* GetFrameTabOriginRegistry() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  static base::NoDestructor<brave_shields::FrameTabOriginRegistry> registry;
+  return registry.get();
+}
+
 }  // namespace
 
 namespace brave_shields {
 
-base::Lock BraveShieldsWebContentsObserver::frame_data_map_lock_;
-std::map<BraveShieldsWebContentsObserver::RenderFrameIdKey, GURL>
-    BraveShieldsWebContentsObserver::frame_key_to_tab_url_;
-std::map<int, GURL>
-    BraveShieldsWebContentsObserver::frame_tree_node_id_to_tab_url_;
-
-BraveShieldsWebContentsObserver::RenderFrameIdKey::RenderFrameIdKey()
-    : render_process_id(content::ChildProcessHost::kInvalidUniqueID),
-      frame_routing_id(MSG_ROUTING_NONE) {}
-
-BraveShieldsWebContentsObserver::RenderFrameIdKey::RenderFrameIdKey(
-    int render_process_id,
-    int frame_routing_id)
-    : render_process_id(render_process_id),
-      frame_routing_id(frame_routing_id) {}
-
-bool BraveShieldsWebContentsObserver::RenderFrameIdKey::operator<(
-    const RenderFrameIdKey& other) const {
-  return std::tie(render_process_id, frame_routing_id) <
-         std::tie(other.render_process_id, other.frame_routing_id);
-}
-
-bool BraveShieldsWebContentsObserver::RenderFrameIdKey::operator==(
-    const RenderFrameIdKey& other) const {
-  return render_process_id == other.render_process_id &&
-         frame_routing_id == other.frame_routing_id;
-}
-
 BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
 }
 
@@ -149,20 +129,17 @@ void BraveShieldsWebContentsObserver::RenderFrameCreated(
   if (web_contents) {
     UpdateContentSettingsToRendererFrames(web_contents);
 
-    base::AutoLock lock(frame_data_map_lock_);
-    const RenderFrameIdKey key(rfh->GetProcess()->GetID(), rfh->GetRoutingID());
-    frame_key_to_tab_url_[key] = web_contents->GetURL();
-    frame_tree_node_id_to_tab_url_[rfh->GetFrameTreeNodeId()] =
-        web_contents->GetURL();
+    GetFrameTabOriginRegistry()->SetTabOrigin(
+        rfh->GetProcess()->GetID(), rfh->GetRoutingID(),
+        rfh->GetFrameTreeNodeId(), web_contents->GetURL());
   }
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameDeleted(
     RenderFrameHost* rfh) {
-  base::AutoLock lock(frame_data_map_lock_);
-  const RenderFrameIdKey key(rfh->GetProcess()->GetID(), rfh->GetRoutingID());
-  frame_key_to_tab_url_.erase(key);
-  frame_tree_node_id_to_tab_url_.erase(rfh->GetFrameTreeNodeId());
+  GetFrameTabOriginRegistry()->RemoveFrame(rfh->GetProcess()->GetID(),
+                                           rfh->GetRoutingID(),
+                                           rfh->GetFrameTreeNodeId());
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameHostChanged(
@@ -185,29 +162,26 @@ void BraveShieldsWebContentsObserver::DidFinishNavigation(
   int routing_id = main_frame->GetRoutingID();
   int tree_node_id = main_frame->GetFrameTreeNodeId();
 
-  base::AutoLock lock(frame_data_map_lock_);
-  frame_key_to_tab_url_[{process_id, routing_id}] = web_contents()->GetURL();
-  frame_tree_node_id_to_tab_url_[tree_node_id] = web_contents()->GetURL();
+#if !defined(OS_ANDROID)
+  // The shields panel starts a new list of blocked resources for every
+  // committed main frame document
+  if (navigation_handle->IsInMainFrame() &&
+      navigation_handle->HasCommitted() &&
+      !navigation_handle->IsSameDocument()) {
+    dispatched_blocked_events_.clear();
+  }
+#endif
+
+  GetFrameTabOriginRegistry()->SetTabOrigin(process_id, routing_id,
+                                            tree_node_id,
+                                            web_contents()->GetURL());
 }
 
 // static
-GURL BraveShieldsWebContentsObserver::GetTabURLFromRenderFrameInfo(
+GURL BraveShieldsWebContentsObserver::GetTabOriginFromRenderFrameInfo(
     int render_process_id, int render_frame_id, int render_frame_tree_node_id) {
-  base::AutoLock lock(frame_data_map_lock_);
-  if (-1 != render_process_id && -1 != render_frame_id) {
-    auto iter = frame_key_to_tab_url_.find({render_process_id,
-                                            render_frame_id});
-    if (iter != frame_key_to_tab_url_.end()) {
-      return iter->second;
-    }
-  }
-  if (-1 != render_frame_tree_node_id) {
-    auto iter2 = frame_tree_node_id_to_tab_url_.find(render_frame_tree_node_id);
-    if (iter2 != frame_tree_node_id_to_tab_url_.end()) {
-      return iter2->second;
-    }
-  }
-  return GURL();
+  return GetFrameTabOriginRegistry()->GetTabOrigin(
+      render_process_id, render_frame_id, render_frame_tree_node_id);
 }
 
 bool BraveShieldsWebContentsObserver::IsBlockedSubresource(
@@ -220,6 +194,40 @@ void BraveShieldsWebContentsObserver::AddBlockedSubresource(
   blocked_url_paths_.insert(subresource);
 }
 
+void BraveShieldsWebContentsObserver::OnBlockedSubresource(
+    const std::string& block_type,
+    const std::string& subresource) {
+#if defined(OS_ANDROID)
+  DispatchBlockedEventForWebContents(block_type, subresource, web_contents());
+#else
+  if (dispatched_blocked_events_.emplace(block_type, subresource).second) {
+    DispatchBlockedEventForWebContents(block_type, subresource,
+                                       web_contents());
+  }
+#endif
+
+  if (!blocked_url_paths_.insert(subresource).second) {
+    return;
+  }
+
+  PrefService* prefs =
+      Profile::FromBrowserContext(web_contents()->GetBrowserContext())
+          ->GetOriginalProfile()
+          ->GetPrefs();
+
+  if (block_type == kAds) {
+    prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
+  } else if (block_type == kHTTPUpgradableResources) {
+    prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
+  } else if (block_type == kJavaScript) {
+    prefs->SetUint64(kJavascriptBlocked,
+                     prefs->GetUint64(kJavascriptBlocked) + 1);
+  } else if (block_type == kFingerprintingV2) {
+    prefs->SetUint64(kFingerprintingBlocked,
+                     prefs->GetUint64(kFingerprintingBlocked) + 1);
+  }
+}
+
 // static
 void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
     std::string block_type,
@@ -231,32 +239,18 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
 
   WebContents* web_contents = GetWebContents(render_process_id,
     render_frame_id, frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
+  if (!web_contents) {
+    return;
+  }
 
-  if (web_contents) {
-    BraveShieldsWebContentsObserver* observer =
-        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
-    if (observer &&
-        !observer->IsBlockedSubresource(subresource)) {
-      observer->AddBlockedSubresource(subresource);
-      PrefService* prefs = Profile::FromBrowserContext(
-          web_contents->GetBrowserContext())->
-          GetOriginalProfile()->
-          GetPrefs();
-
-      if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-      } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-      } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-            prefs->GetUint64(kJavascriptBlocked) + 1);
-      } else if (block_type == kFingerprintingV2) {
-        prefs->SetUint64(kFingerprintingBlocked,
-            prefs->GetUint64(kFingerprintingBlocked) + 1);
-      }
-    }
+  BraveShieldsWebContentsObserver* observer =
+      BraveShieldsWebContentsObserver::FromWebContents(web_contents);
+  if (!observer) {
+    DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
+    return;
   }
+
+  observer->OnBlockedSubresource(block_type, subresource);
 }
 
 #if !defined(OS_ANDROID)
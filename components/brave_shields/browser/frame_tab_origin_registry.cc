@@ -0,0 +1,113 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/frame_tab_origin_registry.h"
+
+#include "base/check_op.h"
+
+namespace brave_shields {
+
+namespace {
+
+uint64_t MakeFrameKey(int render_process_id, int render_frame_id) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(render_process_id))
+          << 32) |
+         static_cast<uint32_t>(render_frame_id);
+}
+
+}  // namespace
+
+FrameTabOriginRegistry::FrameTabOriginRegistry() {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+FrameTabOriginRegistry::~FrameTabOriginRegistry() = default;
+
+void FrameTabOriginRegistry::SetTabOrigin(int render_process_id,
+                                          int render_frame_id,
+                                          int frame_tree_node_id,
+                                          const GURL& tab_url) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  const GURL origin = tab_url.GetOrigin();
+  SetEntry(&frame_origins_, MakeFrameKey(render_process_id, render_frame_id),
+           AddOriginRef(origin));
+  SetEntry(&frame_tree_node_origins_, frame_tree_node_id,
+           AddOriginRef(origin));
+}
+
+void FrameTabOriginRegistry::RemoveFrame(int render_process_id,
+                                         int render_frame_id,
+                                         int frame_tree_node_id) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  RemoveEntry(&frame_origins_,
+              MakeFrameKey(render_process_id, render_frame_id));
+  RemoveEntry(&frame_tree_node_origins_, frame_tree_node_id);
+}
+
+GURL FrameTabOriginRegistry::GetTabOrigin(int render_process_id,
+                                          int render_frame_id,
+                                          int frame_tree_node_id) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (-1 != render_process_id && -1 != render_frame_id) {
+    const auto iter =
+        frame_origins_.find(MakeFrameKey(render_process_id, render_frame_id));
+    if (iter != frame_origins_.end()) {
+      return iter->second->first;
+    }
+  }
+
+  if (-1 != frame_tree_node_id) {
+    const auto iter = frame_tree_node_origins_.find(frame_tree_node_id);
+    if (iter != frame_tree_node_origins_.end()) {
+      return iter->second->first;
+    }
+  }
+
+  return GURL();
+}
+
+FrameTabOriginRegistry::Origins::iterator FrameTabOriginRegistry::AddOriginRef(
+    const GURL& origin) {
+  const auto iter = origins_.emplace(origin, 0).first;
+  ++iter->second;
+  return iter;
+}
+
+void FrameTabOriginRegistry::ReleaseOriginRef(Origins::iterator origin) {
+  DCHECK_GT(origin->second, 0u);
+  if (--origin->second == 0) {
+    origins_.erase(origin);
+  }
+}
+
+template <typename Key>
+void FrameTabOriginRegistry::SetEntry(
+    std::unordered_map<Key, Origins::iterator>* entries,
+    Key key,
+    Origins::iterator origin) {
+  const auto result = entries->emplace(key, origin);
+  if (!result.second) {
+    ReleaseOriginRef(result.first->second);
+    result.first->second = origin;
+  }
+}
+
+template <typename Key>
+void FrameTabOriginRegistry::RemoveEntry(
+    std::unordered_map<Key, Origins::iterator>* entries,
+    Key key) {
+  const auto iter = entries->find(key);
+  if (iter == entries->end()) {
+    return;
+  }
+
+  ReleaseOriginRef(iter->second);
+  entries->erase(iter);
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,77 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_FRAME_TAB_ORIGIN_REGISTRY_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_FRAME_TAB_ORIGIN_REGISTRY_H_
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+
+#include "base/sequence_checker.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+// Maps frames to the origin of the tab containing them, so requests which do
+// not carry a top frame origin can still be attributed to a tab. Frames are
+// registered and requests are set up on the UI thread, so the registry is
+// confined to one sequence and lookups take no lock. Frames of a tab share a
+// single copy of the tab origin.
+class FrameTabOriginRegistry {
+ public:
+  FrameTabOriginRegistry();
+  ~FrameTabOriginRegistry();
+
+  FrameTabOriginRegistry(const FrameTabOriginRegistry&) = delete;
+  FrameTabOriginRegistry& operator=(const FrameTabOriginRegistry&) = delete;
+
+  // Records the origin of |tab_url| for the frame, replacing any previous one
+  void SetTabOrigin(int render_process_id,
+                    int render_frame_id,
+                    int frame_tree_node_id,
+                    const GURL& tab_url);
+
+  void RemoveFrame(int render_process_id,
+                   int render_frame_id,
+                   int frame_tree_node_id);
+
+  // Looks the frame up by process and routing id, then by frame tree node id.
+  // Ids of -1 are ignored. Returns an empty GURL for unknown frames.
+  GURL GetTabOrigin(int render_process_id,
+                    int render_frame_id,
+                    int frame_tree_node_id) const;
+
+  size_t frame_count() const { return frame_origins_.size(); }
+  size_t origin_count() const { return origins_.size(); }
+
+ private:
+  // Tab origins with the number of frame entries referencing them
+  using Origins = std::map<GURL, size_t>;
+
+  Origins::iterator AddOriginRef(const GURL& origin);
+  void ReleaseOriginRef(Origins::iterator origin);
+
+  template <typename Key>
+  void SetEntry(std::unordered_map<Key, Origins::iterator>* entries,
+                Key key,
+                Origins::iterator origin);
+  template <typename Key>
+  void RemoveEntry(std::unordered_map<Key, Origins::iterator>* entries,
+                   Key key);
+
+  Origins origins_;
+
+  // Keyed by the render process id in the high bits and the frame routing id
+  // in the low bits
+  std::unordered_map<uint64_t, Origins::iterator> frame_origins_;
+  std::unordered_map<int, Origins::iterator> frame_tree_node_origins_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_FRAME_TAB_ORIGIN_REGISTRY_H_
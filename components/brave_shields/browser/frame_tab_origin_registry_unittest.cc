@@ -0,0 +1,105 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/frame_tab_origin_registry.h"
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave_shields::FrameTabOriginRegistry;
+
+TEST(FrameTabOriginRegistryTest, UnknownFrame) {
+  FrameTabOriginRegistry registry;
+  EXPECT_EQ(GURL(), registry.GetTabOrigin(1, 2, 3));
+  EXPECT_EQ(GURL(), registry.GetTabOrigin(-1, -1, -1));
+}
+
+TEST(FrameTabOriginRegistryTest, StoresTabOrigin) {
+  FrameTabOriginRegistry registry;
+  registry.SetTabOrigin(1, 2, 3, GURL("https://brave.com/a/b?c#d"));
+  EXPECT_EQ(GURL("https://brave.com/"), registry.GetTabOrigin(1, 2, 3));
+}
+
+TEST(FrameTabOriginRegistryTest, FallsBackToFrameTreeNode) {
+  FrameTabOriginRegistry registry;
+  registry.SetTabOrigin(1, 2, 3, GURL("https://brave.com/"));
+  EXPECT_EQ(GURL("https://brave.com/"), registry.GetTabOrigin(-1, -1, 3));
+  EXPECT_EQ(GURL("https://brave.com/"), registry.GetTabOrigin(4, 5, 3));
+  EXPECT_EQ(GURL("https://brave.com/"), registry.GetTabOrigin(1, 2, -1));
+  EXPECT_EQ(GURL(), registry.GetTabOrigin(1, 5, -1));
+}
+
+TEST(FrameTabOriginRegistryTest, ReplacesTabOrigin) {
+  FrameTabOriginRegistry registry;
+  registry.SetTabOrigin(1, 2, 3, GURL("https://brave.com/"));
+  registry.SetTabOrigin(1, 2, 3, GURL("https://example.com/"));
+  EXPECT_EQ(GURL("https://example.com/"), registry.GetTabOrigin(1, 2, 3));
+  EXPECT_EQ(1u, registry.frame_count());
+  EXPECT_EQ(1u, registry.origin_count());
+}
+
+TEST(FrameTabOriginRegistryTest, RemovesFrame) {
+  FrameTabOriginRegistry registry;
+  registry.SetTabOrigin(1, 2, 3, GURL("https://brave.com/"));
+  registry.RemoveFrame(1, 2, 3);
+  EXPECT_EQ(GURL(), registry.GetTabOrigin(1, 2, 3));
+  EXPECT_EQ(0u, registry.frame_count());
+  EXPECT_EQ(0u, registry.origin_count());
+
+  // Removing an unknown frame is a no-op
+  registry.RemoveFrame(1, 2, 3);
+}
+
+TEST(FrameTabOriginRegistryTest, DistinguishesProcessAndRoutingIds) {
+  FrameTabOriginRegistry registry;
+  registry.SetTabOrigin(1, 2, 10, GURL("https://a.com/"));
+  registry.SetTabOrigin(2, 1, 11, GURL("https://b.com/"));
+  EXPECT_EQ(GURL("https://a.com/"), registry.GetTabOrigin(1, 2, -1));
+  EXPECT_EQ(GURL("https://b.com/"), registry.GetTabOrigin(2, 1, -1));
+}
+
+TEST(FrameTabOriginRegistryTest, ManyFramesShareTabOrigins) {
+  const int kTabs = 20;
+  const int kFramesPerTab = 30;
+
+  FrameTabOriginRegistry registry;
+  for (int tab = 0; tab < kTabs; tab++) {
+    const GURL tab_url("https://tab" + base::NumberToString(tab) +
+                       ".com/page?frame");
+    for (int frame = 0; frame < kFramesPerTab; frame++) {
+      registry.SetTabOrigin(tab, frame, tab * kFramesPerTab + frame, tab_url);
+    }
+  }
+
+  EXPECT_EQ(static_cast<size_t>(kTabs * kFramesPerTab),
+            registry.frame_count());
+  EXPECT_EQ(static_cast<size_t>(kTabs), registry.origin_count());
+
+  for (int tab = 0; tab < kTabs; tab++) {
+    const GURL origin("https://tab" + base::NumberToString(tab) + ".com/");
+    for (int frame = 0; frame < kFramesPerTab; frame++) {
+      EXPECT_EQ(origin, registry.GetTabOrigin(tab, frame, -1));
+      EXPECT_EQ(origin,
+                registry.GetTabOrigin(-1, -1, tab * kFramesPerTab + frame));
+    }
+  }
+
+  // Tear down every other tab
+  for (int tab = 0; tab < kTabs; tab += 2) {
+    for (int frame = 0; frame < kFramesPerTab; frame++) {
+      registry.RemoveFrame(tab, frame, tab * kFramesPerTab + frame);
+    }
+  }
+
+  EXPECT_EQ(static_cast<size_t>(kTabs * kFramesPerTab / 2),
+            registry.frame_count());
+  EXPECT_EQ(static_cast<size_t>(kTabs / 2), registry.origin_count());
+  EXPECT_EQ(GURL(), registry.GetTabOrigin(0, 0, 0));
+  EXPECT_EQ(GURL("https://tab1.com/"),
+            registry.GetTabOrigin(1, 0, kFramesPerTab));
+}
@@ -5,27 +5,27 @@
 
 #include "brave/components/brave_wallet/browser/rlp_decode.h"
 
+#include <limits>
 #include <utility>
 
+#include "base/check.h"
+
 namespace {
 
-// Decodes an integer
-bool RLPToInteger(const std::string& s, size_t* val) {
-  size_t length = s.length();
-  if (length == 0) {
+// Decodes a big endian integer
+bool RLPToInteger(base::span<const uint8_t> s, size_t* val) {
+  if (s.empty()) {
     return false;
   }
 
-  if (length == 1) {
-    *val = static_cast<size_t>(static_cast<uint8_t>(s[0]));
-    return true;
-  }
-
-  size_t v2;
-  if (length <= 1 || !RLPToInteger(s.substr(0, length - 1), &v2)) {
-    return false;
+  size_t v = 0;
+  for (const uint8_t byte : s) {
+    if (v > (std::numeric_limits<size_t>::max() >> 8)) {
+      return false;
+    }
+    v = (v << 8) | byte;
   }
-  *val = static_cast<size_t>(static_cast<uint8_t>(s[length - 1]) + v2 * 256);
+  *val = v;
   return true;
 }
 
@@ -34,138 +34,103 @@ bool IsWithinBounds(size_t offset, size_t data_len, size_t length) {
   return offset <= length && data_len <= length && offset + data_len <= length;
 }
 
-// Decodes an offset, length, and value
-bool RLPDecodeLength(const std::string& s,
+// Decodes the prefix of the item at the start of |s| into its type, the
+// offset of its data and the length of its data
+bool RLPDecodeLength(base::span<const uint8_t> s,
+                     brave_wallet::RLPItem::Type* type,
                      size_t* offset,
-                     size_t* data_len,
-                     base::Value* value) {
-  size_t length = s.length();
+                     size_t* data_len) {
+  const size_t length = s.size();
   if (length == 0) {
     return false;
   }
-  uint8_t prefix = static_cast<uint8_t>(s[0]);
+
+  const uint8_t prefix = s[0];
   if (prefix <= 0x7f) {
+    // A single byte is its own encoding
+    *type = brave_wallet::RLPItem::Type::kString;
     *offset = 0;
     *data_len = 1;
-    std::string str = {s[0]};
-    *value = base::Value(str);
     return true;
   }
 
-  if (prefix <= 0xb7 && length > prefix - 0x80) {
-    size_t strLen = prefix - 0x80;
+  if (prefix <= 0xb7) {
+    // A string of 0-55 bytes
+    *type = brave_wallet::RLPItem::Type::kString;
     *offset = 1;
-    *data_len = strLen;
+    *data_len = prefix - 0x80;
     if (!IsWithinBounds(*offset, *data_len, length)) {
       return false;
     }
-    // If a string length is 1 it should have been handled by the single byte
-    // clause above.
-    if (*data_len == 1) {
+    // A single byte below 0x80 should have been encoded as itself
+    if (*data_len == 1 && s[1] <= 0x7f) {
       return false;
     }
-    std::string str = s.substr(*offset, *data_len);
-    *value = base::Value(str);
     return true;
   }
 
-  size_t i;
-  if (1 + prefix - 0xb7 <= length &&
-      RLPToInteger(s.substr(1, prefix - 0xb7), &i)) {
-    if (prefix <= 0xbf && length > prefix - 0xb7 &&
-        length > prefix - 0xb7 + i) {
-      size_t strLen = i;
-      *offset = 1 + prefix - 0xb7;
-      *data_len = strLen;
-      if (!IsWithinBounds(*offset, *data_len, length)) {
-        return false;
-      }
-      // If a list contains 0-55 bytes, it should have been handled above by
-      // the RLP encoding spec.  So this input should never happen, even though
-      // it could in theory decode properly.
-      if (*data_len <= 55) {
-        return false;
-      }
-
-      std::string str = s.substr(*offset, *data_len);
-      *value = base::Value(str);
-      return true;
+  if (prefix <= 0xbf) {
+    // A longer string, preceded by the length of its length
+    const size_t len_length = prefix - 0xb7;
+    if (!IsWithinBounds(1, len_length, length) ||
+        !RLPToInteger(s.subspan(1, len_length), data_len)) {
+      return false;
     }
+    *type = brave_wallet::RLPItem::Type::kString;
+    *offset = 1 + len_length;
+    // If a string contains 0-55 bytes, it should have been handled above by
+    // the RLP encoding spec.  So this input should never happen, even though
+    // it could in theory decode properly.
+    return *data_len > 55 && IsWithinBounds(*offset, *data_len, length);
   }
 
-  if (prefix <= 0xf7 && length > prefix - 0xc0) {
+  if (prefix <= 0xf7) {
+    // A list with a payload of 0-55 bytes
+    *type = brave_wallet::RLPItem::Type::kList;
     *offset = 1;
     *data_len = prefix - 0xc0;
-    *value = base::ListValue();
-    return true;
+    return IsWithinBounds(*offset, *data_len, length);
   }
 
   // The data is a list if the range of the first byte is [0xf8, 0xff], and the
   // total payload of the list whose length is equal to the first byte minus
   // 0xf7 follows the first byte, and the concatenation of the RLP encodings
   // of all items of the list follows the total payload of the list;
-  size_t list_data_len;
-  size_t list_len_length = prefix - 0xf7;
-  if (prefix <= 0xff && length >= 1 + prefix - 0xf7 &&
-      RLPToInteger(s.substr(1, list_len_length), &list_data_len)) {
-    // Skip past the prefix and the list len length
-    *offset = 1 + list_len_length;
-    *data_len = list_data_len;
-    // If a list contains 0-55 elements, it should have been handled above by
-    // the RLP encoding spec.  So this input should never happen, even though
-    // it could in theory decode properly.
-    if (*data_len <= 55 || !IsWithinBounds(*offset, *data_len, length)) {
-      return false;
-    }
-    *value = base::ListValue();
-    return true;
+  const size_t len_length = prefix - 0xf7;
+  if (!IsWithinBounds(1, len_length, length) ||
+      !RLPToInteger(s.subspan(1, len_length), data_len)) {
+    return false;
   }
-
-  return false;
+  *type = brave_wallet::RLPItem::Type::kList;
+  *offset = 1 + len_length;
+  // If a list contains 0-55 elements, it should have been handled above by
+  // the RLP encoding spec.  So this input should never happen, even though
+  // it could in theory decode properly.
+  return *data_len > 55 && IsWithinBounds(*offset, *data_len, length);
 }
 
-// Decodes a string and gives the result, an offset, and a data_len
-bool RLPDecodeInternal(const std::string& s,
-                       base::Value* output,
-                       size_t* offset,
-                       size_t* data_len) {
-  size_t length = s.length();
-  if (!RLPDecodeLength(s, offset, data_len, output)) {
-    return false;
+// Builds the base::Value tree for a decoded item
+bool RLPItemToValue(const brave_wallet::RLPItem& item, base::Value* output) {
+  if (item.type == brave_wallet::RLPItem::Type::kString) {
+    *output = base::Value(std::string(item.data.begin(), item.data.end()));
+    return true;
   }
 
-  if (output->is_string()) {
-    if (!IsWithinBounds(*offset, *data_len, length)) {
-      return false;
-    }
-    std::string str = s.substr(*offset, *data_len);
-    *output = base::Value(str);
-  } else if (output->is_list()) {
-    *output = base::ListValue();
-    base::ListValue* output_list;
-    if (!output->GetAsList(&output_list)) {
-      return false;
-    }
-    if (!IsWithinBounds(*offset, *data_len, length)) {
+  base::ListValue list;
+  brave_wallet::RLPListReader reader(item);
+  brave_wallet::RLPItem child;
+  while (reader.Next(&child)) {
+    base::Value value;
+    if (!RLPItemToValue(child, &value)) {
       return false;
     }
-    std::string sub = s.substr(*offset, *data_len);
-    while (sub.length() > 0) {
-      base::Value v;
-      size_t offset2, data_len2;
-      if (!RLPDecodeInternal(sub, &v, &offset2, &data_len2)) {
-        return false;
-      }
-      output_list->Append(std::move(v));
-      *offset += data_len2 + offset2;
-      *data_len -= data_len2 + offset2;
-      if (!IsWithinBounds(*offset, *data_len, length)) {
-        return false;
-      }
-      sub = s.substr(*offset, *data_len);
-    }
+    list.Append(std::move(value));
+  }
+  if (reader.error()) {
+    return false;
   }
 
+  *output = std::move(list);
   return true;
 }
 
@@ -173,17 +138,53 @@ bool RLPDecodeInternal(const std::string& s,
 
 namespace brave_wallet {
 
+bool RLPDecodeItem(base::span<const uint8_t> input,
+                   RLPItem* item,
+                   base::span<const uint8_t>* rest) {
+  DCHECK(item);
+  RLPItem::Type type;
+  size_t offset;
+  size_t data_len;
+  if (!RLPDecodeLength(input, &type, &offset, &data_len)) {
+    return false;
+  }
+
+  item->type = type;
+  item->data = input.subspan(offset, data_len);
+  if (rest) {
+    *rest = input.subspan(offset + data_len);
+  }
+  return true;
+}
+
+RLPListReader::RLPListReader(const RLPItem& list) : remaining_(list.data) {
+  DCHECK(list.type == RLPItem::Type::kList);
+}
+
+RLPListReader::~RLPListReader() = default;
+
+bool RLPListReader::Next(RLPItem* item) {
+  if (error_ || remaining_.empty()) {
+    return false;
+  }
+  if (!RLPDecodeItem(remaining_, item, &remaining_)) {
+    error_ = true;
+    return false;
+  }
+  return true;
+}
+
 bool RLPDecode(const std::string& s, base::Value* output) {
   if (!output) {
     return false;
   }
-  size_t offset;
-  size_t data_len;
-  bool result = RLPDecodeInternal(s, output, &offset, &data_len);
-  if (!result) {
+  RLPItem item;
+  if (!RLPDecodeItem(base::as_bytes(base::make_span(s)), &item, nullptr) ||
+      !RLPItemToValue(item, output)) {
     *output = base::Value();
+    return false;
   }
-  return result;
+  return true;
 }
 
 }  // namespace brave_wallet
@@ -6,12 +6,56 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_RLP_DECODE_H_
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_RLP_DECODE_H_
 
+#include <stdint.h>
+
 #include <string>
 
+#include "base/containers/span.h"
 #include "base/values.h"
 
 namespace brave_wallet {
 
+// An RLP item decoded in place. |data| points into the decoded buffer, and
+// holds the bytes of a string, or the encoded items of a list, which can be
+// walked with |RLPListReader|.
+struct RLPItem {
+  enum class Type { kString, kList };
+
+  Type type = Type::kString;
+  base::span<const uint8_t> data;
+};
+
+// Decodes the item at the start of |input| without copying it. On success,
+// |rest| is set to the bytes following the item, if it is not null.
+bool RLPDecodeItem(base::span<const uint8_t> input,
+                   RLPItem* item,
+                   base::span<const uint8_t>* rest);
+
+// Iterates over the items of a decoded RLP list, e.g.
+//
+//   RLPListReader reader(list);
+//   RLPItem item;
+//   while (reader.Next(&item)) {
+//     ...
+//   }
+//   if (reader.error()) {
+//     ...
+//   }
+class RLPListReader {
+ public:
+  explicit RLPListReader(const RLPItem& list);
+  ~RLPListReader();
+
+  // Decodes the next item of the list. Returns false once the list is
+  // exhausted, or if the next item is malformed, see |error|.
+  bool Next(RLPItem* item);
+  bool error() const { return error_; }
+
+ private:
+  base::span<const uint8_t> remaining_;
+  bool error_ = false;
+};
+
 // Recursive Length Prefix (RLP) decoding of arbitrarily nested arrays of data
 // Input string should be a hex string but without the 0x prefix
 bool RLPDecode(const std::string& s, base::Value* output);
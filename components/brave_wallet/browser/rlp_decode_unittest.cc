@@ -3,10 +3,16 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <stdint.h>
+
 #include <string>
+#include <utility>
 
+#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
+#include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/rlp_decode.h"
+#include "brave/components/brave_wallet/browser/rlp_encode.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace {
@@ -45,6 +51,51 @@ std::string FromHex(const std::string& hex_input) {
   return bytes;
 }
 
+std::string ItemToString(const brave_wallet::RLPItem& item) {
+  return std::string(item.data.begin(), item.data.end());
+}
+
+// Pseudo random numbers from a fixed seed, so that failures reproduce
+class TestRandom {
+ public:
+  // Returns a number in [min, max]
+  int Int(int min, int max) {
+    // xorshift64
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 7;
+    state_ ^= state_ << 17;
+    return min + static_cast<int>(state_ % (max - min + 1));
+  }
+
+  std::string Bytes(int length) {
+    std::string bytes;
+    for (int i = 0; i < length; i++) {
+      bytes.push_back(static_cast<char>(Int(0, 255)));
+    }
+    return bytes;
+  }
+
+ private:
+  uint64_t state_ = 0x2545f4914f6cdd1d;
+};
+
+// Builds a random tree of strings and lists, nested up to |depth| levels
+base::Value RandomRLPValue(TestRandom* random, int depth) {
+  if (depth == 0 || random->Int(0, 2) == 0) {
+    // Favor the boundaries between the short and long string encodings
+    const int lengths[] = {0, 1, 55, 56, 57, random->Int(0, 300)};
+    const int length = lengths[random->Int(0, base::size(lengths) - 1)];
+    return base::Value(random->Bytes(length));
+  }
+
+  base::ListValue list;
+  const int size = random->Int(0, 8);
+  for (int i = 0; i < size; i++) {
+    list.Append(RandomRLPValue(random, depth - 1));
+  }
+  return std::move(list);
+}
+
 }  // namespace
 
 namespace brave_wallet {
@@ -396,4 +447,87 @@ TEST(RLPDecodeTest, InvalidInputLessThanLongLengthList2) {
   ASSERT_TRUE(val.is_none());
 }
 
+TEST(RLPDecodeTest, SingleByteAboveSevenBitsIsPrefixed) {
+  base::Value val;
+  ASSERT_TRUE(RLPDecode(FromHex("0x8180"), &val));
+  std::string s;
+  ASSERT_TRUE(val.GetAsString(&s));
+  ASSERT_EQ(std::string(1, '\x80'), s);
+}
+
+TEST(RLPDecodeTest, ItemIsDecodedInPlace) {
+  const std::string input = FromHex("0xc88363617483646f6701");
+  const base::span<const uint8_t> bytes =
+      base::as_bytes(base::make_span(input));
+
+  RLPItem list;
+  base::span<const uint8_t> rest;
+  ASSERT_TRUE(RLPDecodeItem(bytes.first(9), &list, &rest));
+  EXPECT_EQ(RLPItem::Type::kList, list.type);
+  EXPECT_EQ(bytes.data() + 1, list.data.data());
+  EXPECT_EQ(8u, list.data.size());
+  EXPECT_TRUE(rest.empty());
+
+  RLPListReader reader(list);
+  RLPItem item;
+  ASSERT_TRUE(reader.Next(&item));
+  EXPECT_EQ(RLPItem::Type::kString, item.type);
+  EXPECT_EQ("cat", ItemToString(item));
+  EXPECT_EQ(bytes.data() + 2, item.data.data());
+  ASSERT_TRUE(reader.Next(&item));
+  EXPECT_EQ("dog", ItemToString(item));
+  EXPECT_FALSE(reader.Next(&item));
+  EXPECT_FALSE(reader.error());
+
+  // Whatever follows the first item is left for the caller
+  ASSERT_TRUE(RLPDecodeItem(bytes, &list, &rest));
+  ASSERT_EQ(1u, rest.size());
+  EXPECT_EQ(0x01, rest[0]);
+}
+
+TEST(RLPDecodeTest, ListReaderStopsOnMalformedItem) {
+  // The second item claims 3 bytes but nothing is left in the list
+  const std::string input = FromHex("0xc58363617483");
+  RLPItem list;
+  ASSERT_TRUE(
+      RLPDecodeItem(base::as_bytes(base::make_span(input)), &list, nullptr));
+  RLPListReader reader(list);
+  RLPItem item;
+  ASSERT_TRUE(reader.Next(&item));
+  EXPECT_EQ("cat", ItemToString(item));
+  EXPECT_FALSE(reader.Next(&item));
+  EXPECT_TRUE(reader.error());
+  EXPECT_FALSE(reader.Next(&item));
+}
+
+TEST(RLPDecodeTest, RandomRoundTrips) {
+  TestRandom random;
+  for (int i = 0; i < 200; i++) {
+    const base::Value value = RandomRLPValue(&random, 4);
+    const std::string encoded = RLPEncode(value.Clone());
+    base::Value decoded;
+    ASSERT_TRUE(RLPDecode(encoded, &decoded)) << ToHex(encoded);
+    EXPECT_EQ(value, decoded);
+  }
+}
+
+TEST(RLPDecodeTest, RandomInputsDoNotCrash) {
+  TestRandom random;
+  for (int i = 0; i < 2000; i++) {
+    const std::string input = random.Bytes(random.Int(0, 64));
+    base::Value val;
+    RLPDecode(input, &val);
+  }
+
+  // Truncating a valid encoding anywhere must be rejected, not overread
+  const std::string encoded = RLPEncode(RandomRLPValue(&random, 4));
+  for (size_t length = 0; length < encoded.size(); length++) {
+    RLPItem item;
+    base::span<const uint8_t> rest;
+    const std::string truncated = encoded.substr(0, length);
+    EXPECT_FALSE(RLPDecodeItem(base::as_bytes(base::make_span(truncated)),
+                               &item, &rest));
+  }
+}
+
 }  // namespace brave_wallet
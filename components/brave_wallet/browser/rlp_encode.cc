@@ -8,34 +8,130 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/check.h"
+#include "base/check_op.h"
+
 namespace {
 
-std::string RLPToBinary(size_t x) {
+// A list prefix is one byte, followed by up to 8 bytes of length
+constexpr size_t kMaxListPrefixSize = 1 + sizeof(size_t);
+
+// Appends the big endian bytes of |x|, without leading zeros
+void RLPAppendBinary(size_t x, std::string* output) {
   if (x == 0) {
-    return "";
+    return;
   }
-  std::string ret = RLPToBinary(x / 256);
-  ret.push_back(x % 256);
-  return ret;
+  RLPAppendBinary(x / 256, output);
+  output->push_back(x % 256);
 }
 
 std::string RLPEncodeLength(size_t length, size_t offset) {
-  char sz[2] = {0};
+  std::string ret;
   if (length < 56) {
-    sz[0] = length + offset;
-    return sz;
+    ret.push_back(length + offset);
+    return ret;
   }
-  std::string BL = RLPToBinary(length);
-  sz[0] = BL.length() + offset + 55;
-  std::string ret(sz);
+  std::string BL;
+  RLPAppendBinary(length, &BL);
+  ret.push_back(BL.length() + offset + 55);
   ret.append(BL);
   return ret;
 }
 
+void RLPEncodeValue(const base::Value& val, brave_wallet::RLPWriter* writer) {
+  if (val.is_int()) {
+    writer->AddUint256(static_cast<uint256_t>(val.GetInt()));
+  } else if (val.is_blob()) {
+    writer->AddBytes(val.GetBlob());
+  } else if (val.is_string()) {
+    writer->AddString(val.GetString());
+  } else if (val.is_list()) {
+    writer->BeginList();
+    for (const auto& item : val.GetList()) {
+      RLPEncodeValue(item, writer);
+    }
+    writer->EndList();
+  }
+}
+
 }  // namespace
 
 namespace brave_wallet {
 
+RLPWriter::RLPWriter() = default;
+
+RLPWriter::~RLPWriter() = default;
+
+void RLPWriter::AddBytes(base::span<const uint8_t> bytes) {
+  if (bytes.size() != 1 || bytes[0] >= 0x80) {
+    output_.append(RLPEncodeLength(bytes.size(), 0x80));
+  }
+  output_.append(bytes.begin(), bytes.end());
+}
+
+void RLPWriter::AddString(base::StringPiece string) {
+  AddBytes(base::as_bytes(base::make_span(string)));
+}
+
+void RLPWriter::AddUint256(uint256_t value) {
+  uint8_t bytes[32];
+  size_t start = sizeof(bytes);
+  while (value > static_cast<uint256_t>(0)) {
+    bytes[--start] =
+        static_cast<uint8_t>(value & static_cast<uint256_t>(0xFF));
+    value >>= 8;
+  }
+  AddBytes(base::make_span(bytes + start, sizeof(bytes) - start));
+}
+
+void RLPWriter::BeginList() {
+  open_lists_.push_back({output_.size(), unused_bytes_});
+  output_.append(kMaxListPrefixSize, '\0');
+}
+
+void RLPWriter::EndList() {
+  DCHECK(!open_lists_.empty());
+  const OpenList list = open_lists_.back();
+  open_lists_.pop_back();
+
+  // Reserved bytes left unused by nested lists are not part of the encoding
+  const size_t items_start = list.start + kMaxListPrefixSize;
+  const size_t length =
+      output_.size() - items_start - (unused_bytes_ - list.unused_bytes);
+  const std::string prefix = RLPEncodeLength(length, 0xc0);
+  DCHECK_LE(prefix.size(), kMaxListPrefixSize);
+
+  // Write the prefix right before the items
+  const size_t unused = kMaxListPrefixSize - prefix.size();
+  output_.replace(list.start + unused, prefix.size(), prefix);
+  if (unused > 0) {
+    unused_ranges_.emplace_back(list.start, unused);
+    unused_bytes_ += unused;
+  }
+}
+
+std::string RLPWriter::Finish() {
+  DCHECK(open_lists_.empty());
+
+  // Lists end innermost first, so order the ranges by offset before moving
+  // the bytes between them down
+  std::sort(unused_ranges_.begin(), unused_ranges_.end());
+  size_t write = 0;
+  size_t read = 0;
+  for (const auto& range : unused_ranges_) {
+    std::copy(output_.begin() + read, output_.begin() + range.first,
+              output_.begin() + write);
+    write += range.first - read;
+    read = range.first + range.second;
+  }
+  std::copy(output_.begin() + read, output_.end(), output_.begin() + write);
+  output_.resize(write + output_.size() - read);
+
+  unused_ranges_.clear();
+  unused_bytes_ = 0;
+  return std::move(output_);
+}
+
 base::Value RLPUint256ToBlobValue(uint256_t input) {
   base::Value::BlobStorage output;
   while (input > static_cast<uint256_t>(0)) {
@@ -49,29 +145,9 @@ base::Value RLPUint256ToBlobValue(uint256_t input) {
 }
 
 std::string RLPEncode(base::Value val) {
-  if (val.is_int()) {
-    int i;
-    val.GetAsInteger(&i);
-    return RLPEncode(base::Value(RLPUint256ToBlobValue((uint256_t)i)));
-  } else if (val.is_blob()) {
-    base::Value::BlobStorage blob = val.GetBlob();
-    std::string s(blob.begin(), blob.end());
-    if (blob.size() == 1 && static_cast<uint8_t>(blob[0]) < 0x80) {
-      return s;
-    }
-    return RLPEncodeLength(blob.size(), 0x80) + s;
-  } else if (val.is_string()) {
-    std::string s;
-    val.GetAsString(&s);
-    return RLPEncode(base::Value(base::Value::BlobStorage(s.begin(), s.end())));
-  } else if (val.is_list()) {
-    std::string output;
-    for (auto& item : val.GetList()) {
-      output += RLPEncode(std::move(item));
-    }
-    return RLPEncodeLength(output.length(), 0xc0) + output;
-  }
-  return "";
+  RLPWriter writer;
+  RLPEncodeValue(val, &writer);
+  return writer.Finish();
 }
 
 }  // namespace brave_wallet
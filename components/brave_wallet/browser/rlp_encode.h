@@ -6,13 +6,65 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_RLP_ENCODE_H_
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_RLP_ENCODE_H_
 
+#include <stdint.h>
+
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/containers/span.h"
+#include "base/strings/string_piece.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_types.h"
 
 namespace brave_wallet {
 
+// Streams an RLP encoding into a single buffer, without building a
+// base::Value tree first, e.g.
+//
+//   RLPWriter writer;
+//   writer.BeginList();
+//   writer.AddUint256(nonce);
+//   writer.AddBytes(data);
+//   writer.EndList();
+//   std::string encoded = writer.Finish();
+class RLPWriter {
+ public:
+  RLPWriter();
+  ~RLPWriter();
+
+  RLPWriter(const RLPWriter&) = delete;
+  RLPWriter& operator=(const RLPWriter&) = delete;
+
+  void AddBytes(base::span<const uint8_t> bytes);
+  void AddString(base::StringPiece string);
+  // Integers are encoded as big endian bytes without leading zeros
+  void AddUint256(uint256_t value);
+
+  // Items added until the matching |EndList| make up the list. Room for the
+  // list's length prefix is reserved in front of its items, and the unused
+  // part of it is removed by |Finish| in a single pass.
+  void BeginList();
+  void EndList();
+
+  // Returns the encoding of everything added. All lists must have ended.
+  std::string Finish();
+
+ private:
+  struct OpenList {
+    // Offset in |output_| of the space reserved for the list's prefix
+    size_t start;
+    // |unused_bytes_| when the list began
+    size_t unused_bytes;
+  };
+
+  std::string output_;
+  std::vector<OpenList> open_lists_;
+  // Offset and size of the unused reserved bytes of each ended list
+  std::vector<std::pair<size_t, size_t>> unused_ranges_;
+  size_t unused_bytes_ = 0;
+};
+
 // Converts a uint256_t value into a blob value type
 base::Value RLPUint256ToBlobValue(uint256_t input);
 
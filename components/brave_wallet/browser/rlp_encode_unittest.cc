@@ -391,4 +391,65 @@ TEST(RLPEncodeTest, DictionaryValueNotSupported) {
   ASSERT_TRUE(brave_wallet::RLPEncode(std::move(d)).empty());
 }
 
+TEST(RLPEncodeTest, WriterMatchesValueEncoding) {
+  brave_wallet::RLPWriter writer;
+  writer.AddString("cat");
+  writer.BeginList();
+  writer.AddString("puppy");
+  writer.AddString("cow");
+  writer.EndList();
+  writer.AddString("horse");
+  writer.BeginList();
+  writer.BeginList();
+  writer.EndList();
+  writer.EndList();
+  writer.AddString("pig");
+  writer.BeginList();
+  writer.AddString("");
+  writer.EndList();
+  writer.AddString("sheep");
+  // The writer's top level items are not wrapped in a list
+  ASSERT_EQ(ToHex(writer.Finish()),
+            "0x83636174ca85707570707983636f7785686f727365c1c083706967c1808573"
+            "68656570");
+}
+
+TEST(RLPEncodeTest, WriterLongList) {
+  brave_wallet::RLPWriter writer;
+  writer.BeginList();
+  for (int i = 0; i < 30; i++) {
+    writer.AddUint256(i);
+  }
+  writer.EndList();
+  std::string v = writer.Finish();
+
+  base::ListValue list;
+  for (int i = 0; i < 30; i++) {
+    list.Append(brave_wallet::RLPUint256ToBlobValue(i));
+  }
+  ASSERT_EQ(ToHex(v), ToHex(brave_wallet::RLPEncode(std::move(list))));
+  // 30 single byte integers, with 0 encoded as the empty string
+  ASSERT_EQ(ToHex(v).substr(0, 8), "0xde8001");
+}
+
+TEST(RLPEncodeTest, WriterNestedLongLists) {
+  brave_wallet::RLPWriter writer;
+  writer.BeginList();
+  writer.BeginList();
+  for (int i = 0; i < 60; i++) {
+    writer.AddString("a");
+  }
+  writer.EndList();
+  writer.EndList();
+  writer.AddString("b");
+
+  // Both lists are longer than 55 bytes, so their prefixes take two bytes
+  std::string expected = "0xf83ef83c";
+  for (int i = 0; i < 60; i++) {
+    expected += "61";
+  }
+  expected += "62";
+  ASSERT_EQ(ToHex(writer.Finish()), expected);
+}
+
 }  // namespace brave_wallet
@@ -15,6 +15,7 @@ declare namespace NewTab {
   export interface BrandedWallpaper {
     isSponsored: boolean
     wallpaperImageUrl: string
+    nextWallpaperImageUrl?: string
     creativeInstanceId: string
     wallpaperId: string
     logo: BrandedWallpaperLogo
@@ -68,6 +68,30 @@ const char kAds[] = "ads-enabled";
 const char kSupportsMinimumBraveVersion[] =
     "supports-minimum-brave-version";
 
+const struct {
+  const char* key;
+  GreaselionFeature feature;
+} kPreconditionFeatures[] = {
+    {kRewards, REWARDS},
+    {kTwitterTips, TWITTER_TIPS},
+    {kRedditTips, REDDIT_TIPS},
+    {kGithubTips, GITHUB_TIPS},
+    {kAutoContribution, AUTO_CONTRIBUTION},
+    {kAds, ADS},
+    {kSupportsMinimumBraveVersion, SUPPORTS_MINIMUM_BRAVE_VERSION},
+};
+
+bool GetPreconditionFeature(const std::string& key,
+                            GreaselionFeature* feature) {
+  for (const auto& entry : kPreconditionFeatures) {
+    if (key == entry.key) {
+      *feature = entry.feature;
+      return true;
+    }
+  }
+  return false;
+}
+
 GreaselionRule::GreaselionRule(const std::string& name) : name_(name) {}
 
 GreaselionRule::GreaselionRule(const GreaselionRule& name) = default;
@@ -92,25 +116,22 @@ void GreaselionRule::Parse(base::DictionaryValue* preconditions_value,
                            const base::FilePath& resource_dir) {
   if (preconditions_value) {
     for (const auto& kv : preconditions_value->DictItems()) {
-      GreaselionPreconditionValue condition = ParsePrecondition(kv.second);
-      if (kv.first == kRewards) {
-        preconditions_.rewards_enabled = condition;
-      } else if (kv.first == kTwitterTips) {
-        preconditions_.twitter_tips_enabled = condition;
-      } else if (kv.first == kRedditTips) {
-        preconditions_.reddit_tips_enabled = condition;
-      } else if (kv.first == kGithubTips) {
-        preconditions_.github_tips_enabled = condition;
-      } else if (kv.first == kAutoContribution) {
-        preconditions_.auto_contribution_enabled = condition;
-      } else if (kv.first == kAds) {
-        preconditions_.ads_enabled = condition;
-      } else if (kv.first == kSupportsMinimumBraveVersion) {
-        preconditions_.supports_minimum_brave_version = condition;
-      } else {
+      GreaselionFeature feature;
+      if (!GetPreconditionFeature(kv.first, &feature)) {
         LOG(INFO) << "Greaselion encountered an unknown precondition: "
             << kv.first;
         has_unknown_preconditions_ = true;
+        continue;
+      }
+      switch (ParsePrecondition(kv.second)) {
+        case kMustBeTrue:
+          required_features_.set(feature);
+          break;
+        case kMustBeFalse:
+          forbidden_features_.set(feature);
+          break;
+        case kAny:
+          break;
       }
     }
   }
@@ -143,42 +164,12 @@ void GreaselionRule::Parse(base::DictionaryValue* preconditions_value,
 
 GreaselionRule::~GreaselionRule() = default;
 
-bool GreaselionRule::PreconditionFulfilled(
-    GreaselionPreconditionValue precondition,
-    bool value) const {
-  switch (precondition) {
-    case kMustBeTrue:
-      return value;
-    case kMustBeFalse:
-      return !value;
-    default:
-      return true;
-  }
-}
-
-bool GreaselionRule::Matches(
-    GreaselionFeatures state, const base::Version& browser_version) const {
+bool GreaselionRule::Matches(const GreaselionFeatures& state,
+                             const base::Version& browser_version) const {
   // Validate against preconditions.
-  if (!PreconditionFulfilled(preconditions_.rewards_enabled,
-                             state[greaselion::REWARDS]))
-    return false;
-  if (!PreconditionFulfilled(preconditions_.twitter_tips_enabled,
-                             state[greaselion::TWITTER_TIPS]))
-    return false;
-  if (!PreconditionFulfilled(preconditions_.reddit_tips_enabled,
-                             state[greaselion::REDDIT_TIPS]))
-    return false;
-  if (!PreconditionFulfilled(preconditions_.github_tips_enabled,
-                             state[greaselion::GITHUB_TIPS]))
-    return false;
-  if (!PreconditionFulfilled(preconditions_.auto_contribution_enabled,
-                             state[greaselion::AUTO_CONTRIBUTION]))
-    return false;
-  if (!PreconditionFulfilled(preconditions_.supports_minimum_brave_version,
-                          state[greaselion::SUPPORTS_MINIMUM_BRAVE_VERSION]))
+  if ((state & required_features_) != required_features_)
     return false;
-  if (!PreconditionFulfilled(preconditions_.ads_enabled,
-                             state[greaselion::ADS]))
+  if ((state & forbidden_features_).any())
     return false;
   // Validate against browser version.
   if (base::Version::IsValidWildcardString(minimum_brave_version_)) {
@@ -256,6 +247,7 @@ void GreaselionDownloadService::OnDevModeLocalFileChanged(bool error) {
     LOG(ERROR) << "Greaselion encountered an error watching for file changes";
     return;
   }
+  dev_mode_revision_++;
   LOG(INFO) << "Greaselion found a file change and will now reload all rules";
   LoadDirectlyFromResourcePath();
 }
@@ -39,16 +39,6 @@ extern const char kGreaselionConfigFileVersion[];
 
 enum GreaselionPreconditionValue { kMustBeFalse, kMustBeTrue, kAny };
 
-struct GreaselionPreconditions {
-  GreaselionPreconditionValue rewards_enabled = kAny;
-  GreaselionPreconditionValue twitter_tips_enabled = kAny;
-  GreaselionPreconditionValue reddit_tips_enabled = kAny;
-  GreaselionPreconditionValue github_tips_enabled = kAny;
-  GreaselionPreconditionValue auto_contribution_enabled = kAny;
-  GreaselionPreconditionValue ads_enabled = kAny;
-  GreaselionPreconditionValue supports_minimum_brave_version = kAny;
-};
-
 class GreaselionRule {
  public:
   explicit GreaselionRule(const std::string& name);
@@ -63,24 +53,20 @@ class GreaselionRule {
              const std::string& minimum_brave_version_value,
              const base::FilePath& messages_value,
              const base::FilePath& resource_dir);
-  bool Matches(
-      GreaselionFeatures state, const base::Version& browser_version) const;
-  std::string name() const { return name_; }
-  std::vector<std::string> url_patterns() const { return url_patterns_; }
-  std::vector<base::FilePath> scripts() const { return scripts_; }
-  std::string run_at() const {
-    return run_at_;
-  }
-  base::FilePath messages() const {
-    return messages_;
+  bool Matches(const GreaselionFeatures& state,
+               const base::Version& browser_version) const;
+  const std::string& name() const { return name_; }
+  const std::vector<std::string>& url_patterns() const {
+    return url_patterns_;
   }
+  const std::vector<base::FilePath>& scripts() const { return scripts_; }
+  const std::string& run_at() const { return run_at_; }
+  const base::FilePath& messages() const { return messages_; }
   bool has_unknown_preconditions() const { return has_unknown_preconditions_; }
 
  private:
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
   GreaselionPreconditionValue ParsePrecondition(const base::Value& value);
-  bool PreconditionFulfilled(GreaselionPreconditionValue precondition,
-                             bool value) const;
 
   std::string name_;
   std::vector<std::string> url_patterns_;
@@ -88,7 +74,10 @@ class GreaselionRule {
   std::string run_at_;
   std::string minimum_brave_version_;
   base::FilePath messages_;
-  GreaselionPreconditions preconditions_;
+  // Preconditions folded into the features which must be enabled and the
+  // ones which must be disabled for the rule to apply.
+  GreaselionFeatures required_features_;
+  GreaselionFeatures forbidden_features_;
   bool has_unknown_preconditions_ = false;
 };
 
@@ -102,6 +91,10 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
   ~GreaselionDownloadService() override;
 
   std::vector<std::unique_ptr<GreaselionRule>>* rules();
+  // Bumped each time dev mode reloads the rules. Scripts are edited in place
+  // there, so unchanged rules still need their extensions rebuilt, whereas
+  // component updates install to a new versioned directory.
+  int dev_mode_revision() const { return dev_mode_revision_; }
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
 
   // implementation of LocalDataFilesObserver
@@ -131,6 +124,7 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
   std::vector<std::unique_ptr<GreaselionRule>> rules_;
   base::FilePath resource_dir_;
   bool is_dev_mode_ = false;
+  int dev_mode_revision_ = 0;
   scoped_refptr<base::SequencedTaskRunner> dev_mode_task_runner_;
   std::unique_ptr<base::FilePathWatcher> dev_mode_path_watcher_;
 
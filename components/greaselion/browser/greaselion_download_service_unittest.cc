@@ -0,0 +1,143 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/json/json_reader.h"
+#include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+#include "base/version.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace greaselion {
+
+namespace {
+
+const char kBrowserVersion[] = "1.2.3.4";
+
+std::unique_ptr<GreaselionRule> ParseRule(
+    const std::string& preconditions_json,
+    const std::string& minimum_brave_version = std::string()) {
+  base::Optional<base::Value> preconditions =
+      base::JSONReader::Read(preconditions_json);
+  EXPECT_TRUE(preconditions && preconditions->is_dict());
+  base::ListValue urls;
+  urls.AppendString("https://www.example.com/*");
+  base::ListValue scripts;
+  scripts.AppendString("scripts/example-com.js");
+
+  auto rule = std::make_unique<GreaselionRule>("greaselion-0");
+  base::DictionaryValue* preconditions_dict = nullptr;
+  preconditions->GetAsDictionary(&preconditions_dict);
+  rule->Parse(preconditions_dict, &urls, &scripts, std::string(),
+              minimum_brave_version, base::FilePath(),
+              base::FilePath(FILE_PATH_LITERAL("resources")));
+  return rule;
+}
+
+GreaselionFeatures MakeFeatures(std::initializer_list<GreaselionFeature> on) {
+  GreaselionFeatures features;
+  for (GreaselionFeature feature : on)
+    features.set(feature);
+  return features;
+}
+
+}  // namespace
+
+TEST(GreaselionRuleTest, NoPreconditions) {
+  const base::Version version(kBrowserVersion);
+  auto rule = ParseRule("{}");
+  EXPECT_FALSE(rule->has_unknown_preconditions());
+  EXPECT_TRUE(rule->Matches(GreaselionFeatures(), version));
+  EXPECT_TRUE(rule->Matches(GreaselionFeatures().set(), version));
+  ASSERT_EQ(1u, rule->url_patterns().size());
+  EXPECT_EQ(base::FilePath(FILE_PATH_LITERAL("resources"))
+                .AppendASCII("scripts/example-com.js"),
+            rule->scripts()[0]);
+}
+
+TEST(GreaselionRuleTest, RequiredAndForbiddenFeatures) {
+  const base::Version version(kBrowserVersion);
+  auto rule = ParseRule(
+      R"({"rewards-enabled": true, "ads-enabled": false,
+          "twitter-tips-enabled": "maybe"})");
+  EXPECT_FALSE(rule->has_unknown_preconditions());
+
+  EXPECT_FALSE(rule->Matches(GreaselionFeatures(), version));
+  EXPECT_TRUE(rule->Matches(MakeFeatures({REWARDS}), version));
+  EXPECT_FALSE(rule->Matches(MakeFeatures({REWARDS, ADS}), version));
+  // Values other than booleans don't constrain the feature.
+  EXPECT_TRUE(rule->Matches(MakeFeatures({REWARDS, TWITTER_TIPS}), version));
+  EXPECT_TRUE(
+      rule->Matches(MakeFeatures({REWARDS, GITHUB_TIPS, AUTO_CONTRIBUTION}),
+                    version));
+}
+
+TEST(GreaselionRuleTest, UnknownPrecondition) {
+  auto rule = ParseRule(R"({"rewards-enabled": true, "unknown": true})");
+  EXPECT_TRUE(rule->has_unknown_preconditions());
+  EXPECT_TRUE(
+      rule->Matches(MakeFeatures({REWARDS}), base::Version(kBrowserVersion)));
+}
+
+TEST(GreaselionRuleTest, MinimumBraveVersion) {
+  const base::Version version(kBrowserVersion);
+  const GreaselionFeatures features =
+      MakeFeatures({SUPPORTS_MINIMUM_BRAVE_VERSION});
+  EXPECT_TRUE(ParseRule("{}", "1.2.*")->Matches(features, version));
+  EXPECT_TRUE(ParseRule("{}", "1.2.3.4")->Matches(features, version));
+  EXPECT_FALSE(ParseRule("{}", "1.3.*")->Matches(features, version));
+  EXPECT_TRUE(ParseRule("{}", "bad")->Matches(features, version));
+
+  auto rule = ParseRule(R"({"supports-minimum-brave-version": true})");
+  EXPECT_TRUE(rule->Matches(features, version));
+  EXPECT_FALSE(rule->Matches(GreaselionFeatures(), version));
+}
+
+TEST(GreaselionRuleTest, ManyRules) {
+  const char* const kKeys[] = {
+      "rewards-enabled",           "twitter-tips-enabled",
+      "reddit-tips-enabled",       "github-tips-enabled",
+      "auto-contribution-enabled", "ads-enabled",
+  };
+  const GreaselionFeature kFeatures[] = {
+      REWARDS, TWITTER_TIPS, REDDIT_TIPS, GITHUB_TIPS, AUTO_CONTRIBUTION, ADS,
+  };
+  const size_t kCount = base::size(kKeys);
+  const base::Version version(kBrowserVersion);
+
+  // Each rule requires feature i % kCount, and forbids feature (i / kCount) %
+  // kCount unless that is the same one.
+  for (size_t i = 0; i < 300; i++) {
+    const size_t required = i % kCount;
+    const size_t forbidden = (i / kCount) % kCount;
+    std::string json = std::string("{\"") + kKeys[required] + "\": true";
+    if (forbidden != required)
+      json += std::string(", \"") + kKeys[forbidden] + "\": false";
+    json += "}";
+    auto rule = ParseRule(json);
+
+    for (size_t state = 0; state < (1u << kCount); state++) {
+      GreaselionFeatures features;
+      for (size_t bit = 0; bit < kCount; bit++) {
+        if (state & (1u << bit))
+          features.set(kFeatures[bit]);
+      }
+      const bool expected =
+          (state & (1u << required)) &&
+          (forbidden == required || !(state & (1u << forbidden)));
+      EXPECT_EQ(expected, rule->Matches(features, version))
+          << json << " state " << base::NumberToString(state);
+    }
+  }
+}
+
+}  // namespace greaselion
@@ -6,7 +6,7 @@
 #ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_SERVICE_H_
 #define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_SERVICE_H_
 
-#include <map>
+#include <bitset>
 #include <string>
 #include <vector>
 
@@ -37,7 +37,8 @@ enum GreaselionFeature {
   LAST_FEATURE
 };
 
-typedef std::map<GreaselionFeature, bool> GreaselionFeatures;
+// One bit per GreaselionFeature, set when the feature is enabled.
+typedef std::bitset<LAST_FEATURE> GreaselionFeatures;
 
 class GreaselionService : public KeyedService,
                           public extensions::ExtensionRegistryObserver {
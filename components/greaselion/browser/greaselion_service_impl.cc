@@ -21,6 +21,8 @@
 #include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -186,6 +188,27 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   // the service exits
   return std::make_pair(extension, std::move(temp_dir));
 }
+
+// Identifies the extension built from |rule|. The extension ID only depends on
+// the rule name, so this also covers everything else which ends up in the
+// extension, making a changed rule look like a new one.
+std::string GetRuleKey(const greaselion::GreaselionRule& rule,
+                       int dev_mode_revision) {
+  std::string key = rule.name();
+  key += '\n' + rule.run_at();
+  key += '\n' + rule.messages().AsUTF8Unsafe();
+  for (const std::string& url_pattern : rule.url_patterns())
+    key += '\n' + url_pattern;
+  for (const base::FilePath& script : rule.scripts())
+    key += '\n' + script.AsUTF8Unsafe();
+  key += '\n' + base::NumberToString(dev_mode_revision);
+  return key;
+}
+
+void DeleteTempDir(base::ScopedTempDir temp_dir) {
+  ignore_result(temp_dir.Delete());
+}
+
 }  // namespace
 
 namespace greaselion {
@@ -210,8 +233,6 @@ GreaselionServiceImpl::GreaselionServiceImpl(
           version_info::GetBraveVersionWithoutChromiumMajorVersion()),
       weak_factory_(this) {
   extension_registry_->AddObserver(this);
-  for (int i = FIRST_FEATURE; i != LAST_FEATURE; i++)
-    state_[static_cast<GreaselionFeature>(i)] = false;
   // Static-value features
   state_[GreaselionFeature::SUPPORTS_MINIMUM_BRAVE_VERSION] = true;
 }
@@ -221,13 +242,15 @@ GreaselionServiceImpl::~GreaselionServiceImpl() {
 }
 
 bool GreaselionServiceImpl::IsGreaselionExtension(const std::string& id) {
-  return std::find(greaselion_extensions_.begin(), greaselion_extensions_.end(),
-                   id) != greaselion_extensions_.end();
+  return base::Contains(greaselion_extensions_, id);
 }
 
 std::vector<extensions::ExtensionId>
 GreaselionServiceImpl::GetExtensionIdsForTesting() {
-  return greaselion_extensions_;
+  std::vector<extensions::ExtensionId> ids;
+  for (const auto& extension : greaselion_extensions_)
+    ids.push_back(extension.first);
+  return ids;
 }
 
 void GreaselionServiceImpl::UpdateInstalledExtensions() {
@@ -236,61 +259,79 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
     return;
   }
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
+
+  // Work out which rules apply now, keeping the extensions of those that are
+  // already installed and unchanged.
+  const int dev_mode_revision = download_service_->dev_mode_revision();
+  std::set<std::string> rule_keys;
+  rules_to_install_.clear();
+  std::set<std::string> installed_rule_keys;
+  for (const auto& extension : greaselion_extensions_)
+    installed_rule_keys.insert(extension.second);
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    if (rule->has_unknown_preconditions() ||
+        !rule->Matches(state_, browser_version_)) {
+      continue;
+    }
+    std::string rule_key = GetRuleKey(*rule, dev_mode_revision);
+    if (!base::Contains(installed_rule_keys, rule_key))
+      rules_to_install_.push_back(*rule);
+    rule_keys.insert(std::move(rule_key));
+  }
+
+  pending_unloads_.clear();
+  for (const auto& extension : greaselion_extensions_) {
+    if (!base::Contains(rule_keys, extension.second))
+      pending_unloads_.insert(extension.first);
+  }
+  if (pending_unloads_.empty()) {
+    // Nothing to unload, so we can move on to the install phase immediately.
     CreateAndInstallExtensions();
     return;
   }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
-  // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
-  for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
+  // Make a copy of pending_unloads_ to iterate while the original set changes.
+  std::set<extensions::ExtensionId> extensions = pending_unloads_;
+  for (const auto& id : extensions) {
+    // We need to unload the extensions of rules which no longer apply or have
+    // changed, as a changed rule is rebuilt with the same extension ID.
+    // OnExtensionUnloaded will be called on each extension, where we will
+    // update the pending_unloads_ set. Once it's empty, that callback will
+    // call CreateAndInstallExtensions().
     extension_service_->UnloadExtension(
         id, extensions::UnloadedExtensionReason::UPDATE);
   }
 }
 
 void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
+  DCHECK(pending_unloads_.empty());
   DCHECK(update_in_progress_);
   all_rules_installed_successfully_ = true;
-  pending_installs_ = 0;
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
-    }
-  }
+  pending_installs_ = static_cast<int>(rules_to_install_.size());
   if (!pending_installs_) {
-    // no rules match, nothing else to do
+    // no new rules match, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      GreaselionRule rule_copy(*rule);
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule_copy, install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
+  const int dev_mode_revision = download_service_->dev_mode_revision();
+  std::vector<GreaselionRule> rules;
+  rules.swap(rules_to_install_);
+  for (const GreaselionRule& rule : rules) {
+    // Convert script file to component extension. This must run on extension
+    // file task runner, which was passed in in the constructor.
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner, rule,
+                       install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(),
+                       GetRuleKey(rule, dev_mode_revision)));
   }
 }
 
 void GreaselionServiceImpl::PostConvert(
+    const std::string& rule_key,
     base::Optional<GreaselionConvertedExtension> converted_extension) {
   if (!converted_extension) {
     all_rules_installed_successfully_ = false;
@@ -298,8 +339,10 @@ void GreaselionServiceImpl::PostConvert(
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(converted_extension->first->id());
-    extension_dirs_.push_back(std::move(converted_extension->second));
+    const extensions::ExtensionId& id = converted_extension->first->id();
+    greaselion_extensions_[id] = rule_key;
+    DCHECK(!base::Contains(extension_dirs_, id));
+    extension_dirs_[id] = std::move(converted_extension->second);
     extension_system_->ready().Post(
         FROM_HERE, base::BindOnce(&GreaselionServiceImpl::Install,
                                   weak_factory_.GetWeakPtr(),
@@ -315,9 +358,7 @@ void GreaselionServiceImpl::Install(
 void GreaselionServiceImpl::OnExtensionReady(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
+  if (!IsGreaselionExtension(extension->id())) {
     // not one of ours
     return;
   }
@@ -330,14 +371,24 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension,
     extensions::UnloadedExtensionReason reason) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
+  auto index = greaselion_extensions_.find(extension->id());
   if (index == greaselion_extensions_.end()) {
     // not one of ours
     return;
   }
   greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
+
+  // The extension's files are no longer needed, so delete them off the UI
+  // thread rather than when the service exits.
+  auto dir = extension_dirs_.find(extension->id());
+  if (dir != extension_dirs_.end()) {
+    task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&DeleteTempDir, std::move(dir->second)));
+    extension_dirs_.erase(dir);
+  }
+
+  if (update_in_progress_ && pending_unloads_.erase(extension->id()) &&
+      pending_unloads_.empty()) {
     // It's time!
     CreateAndInstallExtensions();
   }
@@ -367,6 +418,8 @@ void GreaselionServiceImpl::MaybeNotifyObservers() {
 void GreaselionServiceImpl::SetFeatureEnabled(GreaselionFeature feature,
                                               bool enabled) {
   DCHECK(feature >= 0 && feature < LAST_FEATURE);
+  if (state_[feature] == enabled)
+    return;
   state_[feature] = enabled;
   UpdateInstalledExtensions();
 }
@@ -8,6 +8,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -36,6 +37,7 @@ class ExtensionSystem;
 namespace greaselion {
 
 class GreaselionDownloadService;
+class GreaselionRule;
 
 class GreaselionServiceImpl : public GreaselionService {
  public:
@@ -70,6 +72,7 @@ class GreaselionServiceImpl : public GreaselionService {
   void SetBrowserVersionForTesting(const base::Version& version) override;
   void CreateAndInstallExtensions();
   void PostConvert(
+      const std::string& rule_key,
       base::Optional<GreaselionConvertedExtension> converted_extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
@@ -86,8 +89,14 @@ class GreaselionServiceImpl : public GreaselionService {
   int pending_installs_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
-  std::vector<extensions::ExtensionId> greaselion_extensions_;
-  std::vector<base::ScopedTempDir> extension_dirs_;
+  // Installed extensions, mapped to the key of the rule each one was built
+  // from, so an update only rebuilds the extensions whose rules changed.
+  std::map<extensions::ExtensionId, std::string> greaselion_extensions_;
+  std::map<extensions::ExtensionId, base::ScopedTempDir> extension_dirs_;
+  // Extensions which the update in progress is waiting to be unloaded, and
+  // the rules it installs once they are.
+  std::set<extensions::ExtensionId> pending_unloads_;
+  std::vector<GreaselionRule> rules_to_install_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
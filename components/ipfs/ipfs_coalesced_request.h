@@ -0,0 +1,85 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_IPFS_COALESCED_REQUEST_H_
+#define BRAVE_COMPONENTS_IPFS_IPFS_COALESCED_REQUEST_H_
+
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace ipfs {
+
+// Shares a single request to the local daemon between all callers that ask
+// for the same data while it is in flight. A successful response is reused
+// for |ttl| so that several pages polling the daemon do not multiply the
+// number of requests.
+template <typename T>
+class CoalescedRequest {
+ public:
+  using Callback = base::OnceCallback<void(bool, const T&)>;
+
+  explicit CoalescedRequest(base::TimeDelta ttl) : ttl_(ttl) {}
+  ~CoalescedRequest() = default;
+
+  // Runs |callback| right away if there is a fresh response, otherwise queues
+  // it. Returns true if the caller should start a new request.
+  bool AddCallback(Callback callback) {
+    if (!in_flight_ && HasFreshResponse()) {
+      if (callback)
+        std::move(callback).Run(true, last_response_);
+      return false;
+    }
+
+    callbacks_.push_back(std::move(callback));
+    if (in_flight_)
+      return false;
+
+    in_flight_ = true;
+    return true;
+  }
+
+  // Runs all queued callbacks with the response.
+  void Complete(bool success, const T& response) {
+    in_flight_ = false;
+    if (success) {
+      last_response_ = response;
+      last_response_time_ = base::TimeTicks::Now();
+    }
+
+    std::vector<Callback> callbacks = std::move(callbacks_);
+    callbacks_.clear();
+    for (auto& callback : callbacks) {
+      if (callback)
+        std::move(callback).Run(success, response);
+    }
+  }
+
+  // Drops the cached response, e.g. when the daemon is restarted.
+  void Invalidate() { last_response_time_ = base::TimeTicks(); }
+
+  bool in_flight() const { return in_flight_; }
+
+ private:
+  bool HasFreshResponse() const {
+    return !last_response_time_.is_null() &&
+           base::TimeTicks::Now() - last_response_time_ < ttl_;
+  }
+
+  const base::TimeDelta ttl_;
+  bool in_flight_ = false;
+  std::vector<Callback> callbacks_;
+  T last_response_;
+  base::TimeTicks last_response_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(CoalescedRequest);
+};
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_IPFS_COALESCED_REQUEST_H_
@@ -0,0 +1,99 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/ipfs_coalesced_request.h"
+
+#include "base/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ipfs {
+
+namespace {
+
+constexpr base::TimeDelta kTTL = base::TimeDelta::FromSeconds(2);
+
+class IpfsCoalescedRequestTest : public testing::Test {
+ public:
+  IpfsCoalescedRequestTest() = default;
+
+  CoalescedRequest<int>::Callback GetCallback() {
+    return base::BindOnce(&IpfsCoalescedRequestTest::OnResponse,
+                          base::Unretained(this));
+  }
+
+  void OnResponse(bool success, const int& response) {
+    responses_++;
+    last_success_ = success;
+    last_response_ = response;
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  int responses_ = 0;
+  bool last_success_ = false;
+  int last_response_ = 0;
+};
+
+}  // namespace
+
+TEST_F(IpfsCoalescedRequestTest, ConcurrentCallersShareOneRequest) {
+  CoalescedRequest<int> request(kTTL);
+  EXPECT_TRUE(request.AddCallback(GetCallback()));
+  EXPECT_FALSE(request.AddCallback(GetCallback()));
+  EXPECT_FALSE(request.AddCallback(base::NullCallback()));
+  EXPECT_TRUE(request.in_flight());
+  EXPECT_EQ(responses_, 0);
+
+  request.Complete(true, 42);
+  EXPECT_FALSE(request.in_flight());
+  EXPECT_EQ(responses_, 2);
+  EXPECT_TRUE(last_success_);
+  EXPECT_EQ(last_response_, 42);
+}
+
+TEST_F(IpfsCoalescedRequestTest, FreshResponseIsCached) {
+  CoalescedRequest<int> request(kTTL);
+  EXPECT_TRUE(request.AddCallback(GetCallback()));
+  request.Complete(true, 42);
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_FALSE(request.AddCallback(GetCallback()));
+  EXPECT_EQ(responses_, 2);
+  EXPECT_EQ(last_response_, 42);
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_TRUE(request.AddCallback(GetCallback()));
+  EXPECT_EQ(responses_, 2);
+}
+
+TEST_F(IpfsCoalescedRequestTest, FailureIsNotCached) {
+  CoalescedRequest<int> request(kTTL);
+  EXPECT_TRUE(request.AddCallback(GetCallback()));
+  request.Complete(false, 0);
+  EXPECT_EQ(responses_, 1);
+  EXPECT_FALSE(last_success_);
+
+  EXPECT_TRUE(request.AddCallback(GetCallback()));
+}
+
+TEST_F(IpfsCoalescedRequestTest, ZeroTTLDisablesCache) {
+  CoalescedRequest<int> request((base::TimeDelta()));
+  EXPECT_TRUE(request.AddCallback(GetCallback()));
+  request.Complete(true, 42);
+  EXPECT_TRUE(request.AddCallback(GetCallback()));
+}
+
+TEST_F(IpfsCoalescedRequestTest, Invalidate) {
+  CoalescedRequest<int> request(kTTL);
+  EXPECT_TRUE(request.AddCallback(GetCallback()));
+  request.Complete(true, 42);
+
+  request.Invalidate();
+  EXPECT_TRUE(request.AddCallback(GetCallback()));
+  EXPECT_EQ(responses_, 1);
+}
+
+}  // namespace ipfs
@@ -45,6 +45,10 @@ namespace {
 const int kMinimalPeersRetryIntervalMs = 350;
 const int kPeersRetryRate = 3;
 
+// Daemon responses are reused for this long, connected peers are not cached
+// since navigation throttles rely on an up to date answer.
+constexpr base::TimeDelta kResponseCacheTTL = base::TimeDelta::FromSeconds(2);
+
 net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
   return net::DefineNetworkTrafficAnnotation("ipfs_service", R"(
       semantics {
@@ -91,6 +95,10 @@ IpfsService::IpfsService(content::BrowserContext* context,
     : context_(context),
       server_endpoint_(GetAPIServer(channel)),
       user_data_dir_(user_data_dir),
+      connected_peers_request_(base::TimeDelta()),
+      addresses_config_request_(kResponseCacheTTL),
+      repo_stats_request_(kResponseCacheTTL),
+      node_info_request_(kResponseCacheTTL),
       ipfs_client_updater_(ipfs_client_updater),
       channel_(channel),
       file_task_runner_(base::CreateSequencedTaskRunner(
@@ -252,6 +260,14 @@ void IpfsService::Shutdown() {
 
   ipfs_service_.reset();
   ipfs_pid_ = -1;
+  InvalidateResponses();
+}
+
+void IpfsService::InvalidateResponses() {
+  connected_peers_request_.Invalidate();
+  addresses_config_request_.Invalidate();
+  repo_stats_request_.Invalidate();
+  node_info_request_.Invalidate();
 }
 
 std::unique_ptr<network::SimpleURLLoader> IpfsService::CreateURLLoader(
@@ -287,13 +303,23 @@ void IpfsService::GetConnectedPeers(GetConnectedPeersCallback callback,
     return;
   }
 
+  if (connected_peers_request_.AddCallback(std::move(callback)))
+    RequestConnectedPeers(retries);
+}
+
+void IpfsService::RequestConnectedPeers(int retries) {
+  if (!IsDaemonLaunched()) {
+    connected_peers_request_.Complete(false, std::vector<std::string>{});
+    return;
+  }
+
   auto url_loader = CreateURLLoader(server_endpoint_.Resolve(kSwarmPeersPath));
   auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
 
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
       base::BindOnce(&IpfsService::OnGetConnectedPeers, base::Unretained(this),
-                     std::move(iter), std::move(callback), retries));
+                     std::move(iter), retries));
 }
 
 base::TimeDelta IpfsService::CalculatePeersRetryTime() {
@@ -306,7 +332,6 @@ base::TimeDelta IpfsService::CalculatePeersRetryTime() {
 
 void IpfsService::OnGetConnectedPeers(
     SimpleURLLoaderList::iterator iter,
-    GetConnectedPeersCallback callback,
     int retry_number,
     std::unique_ptr<std::string> response_body) {
   auto* url_loader = iter->get();
@@ -319,9 +344,8 @@ void IpfsService::OnGetConnectedPeers(
   if (error_code == net::ERR_CONNECTION_REFUSED && retry_number) {
     base::SequencedTaskRunnerHandle::Get()->PostDelayedTask(
         FROM_HERE,
-        base::BindOnce(&IpfsService::GetConnectedPeers,
-                       weak_factory_.GetWeakPtr(), std::move(callback),
-                       retry_number - 1),
+        base::BindOnce(&IpfsService::RequestConnectedPeers,
+                       weak_factory_.GetWeakPtr(), retry_number - 1),
         CalculatePeersRetryTime());
     return;
   }
@@ -336,8 +360,7 @@ void IpfsService::OnGetConnectedPeers(
   if (success)
     success = IPFSJSONParser::GetPeersFromJSON(*response_body, &peers);
 
-  if (callback)
-    std::move(callback).Run(success, peers);
+  connected_peers_request_.Complete(success, peers);
 
   for (auto& observer : observers_) {
     observer.OnGetConnectedPeers(success, peers);
@@ -346,10 +369,14 @@ void IpfsService::OnGetConnectedPeers(
 
 void IpfsService::GetAddressesConfig(GetAddressesConfigCallback callback) {
   if (!IsDaemonLaunched()) {
-    std::move(callback).Run(false, AddressesConfig());
+    if (callback)
+      std::move(callback).Run(false, AddressesConfig());
     return;
   }
 
+  if (!addresses_config_request_.AddCallback(std::move(callback)))
+    return;
+
   GURL gurl = net::AppendQueryParameter(server_endpoint_.Resolve(kConfigPath),
                                         kArgQueryParam, kAddressesField);
   auto url_loader = CreateURLLoader(gurl);
@@ -358,12 +385,11 @@ void IpfsService::GetAddressesConfig(GetAddressesConfigCallback callback) {
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
       base::BindOnce(&IpfsService::OnGetAddressesConfig, base::Unretained(this),
-                     std::move(iter), std::move(callback)));
+                     std::move(iter)));
 }
 
 void IpfsService::OnGetAddressesConfig(
     SimpleURLLoaderList::iterator iter,
-    GetAddressesConfigCallback callback,
     std::unique_ptr<std::string> response_body) {
   auto* url_loader = iter->get();
   int error_code = url_loader->NetError();
@@ -376,13 +402,12 @@ void IpfsService::OnGetAddressesConfig(
   if (error_code != net::OK || response_code != net::HTTP_OK) {
     VLOG(1) << "Fail to get addresses config, error_code = " << error_code
             << " response_code = " << response_code;
-    std::move(callback).Run(false, addresses_config);
-    return;
   }
 
-  bool success = IPFSJSONParser::GetAddressesConfigFromJSON(*response_body,
+  bool success = error_code == net::OK && response_code == net::HTTP_OK &&
+                 IPFSJSONParser::GetAddressesConfigFromJSON(*response_body,
                                                             &addresses_config);
-  std::move(callback).Run(success, addresses_config);
+  addresses_config_request_.Complete(success, addresses_config);
 }
 
 bool IpfsService::IsDaemonLaunched() const {
@@ -500,10 +525,14 @@ IPFSResolveMethodTypes IpfsService::GetIPFSResolveMethodType() const {
 
 void IpfsService::GetRepoStats(GetRepoStatsCallback callback) {
   if (!IsDaemonLaunched()) {
-    std::move(callback).Run(false, RepoStats());
+    if (callback)
+      std::move(callback).Run(false, RepoStats());
     return;
   }
 
+  if (!repo_stats_request_.AddCallback(std::move(callback)))
+    return;
+
   GURL gurl =
       net::AppendQueryParameter(server_endpoint_.Resolve(ipfs::kRepoStatsPath),
                                 ipfs::kRepoStatsHumanReadableParamName,
@@ -514,11 +543,10 @@ void IpfsService::GetRepoStats(GetRepoStatsCallback callback) {
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
       base::BindOnce(&IpfsService::OnRepoStats, base::Unretained(this),
-                     std::move(iter), std::move(callback)));
+                     std::move(iter)));
 }
 
 void IpfsService::OnRepoStats(SimpleURLLoaderList::iterator iter,
-                              GetRepoStatsCallback callback,
                               std::unique_ptr<std::string> response_body) {
   auto* url_loader = iter->get();
   int error_code = url_loader->NetError();
@@ -531,21 +559,24 @@ void IpfsService::OnRepoStats(SimpleURLLoaderList::iterator iter,
   if (error_code != net::OK || response_code != net::HTTP_OK) {
     VLOG(1) << "Fail to get repro stats, error_code = " << error_code
             << " response_code = " << response_code;
-    std::move(callback).Run(false, repo_stats);
-    return;
   }
 
   bool success =
+      error_code == net::OK && response_code == net::HTTP_OK &&
       IPFSJSONParser::GetRepoStatsFromJSON(*response_body, &repo_stats);
-  std::move(callback).Run(success, repo_stats);
+  repo_stats_request_.Complete(success, repo_stats);
 }
 
 void IpfsService::GetNodeInfo(GetNodeInfoCallback callback) {
   if (!IsDaemonLaunched()) {
-    std::move(callback).Run(false, NodeInfo());
+    if (callback)
+      std::move(callback).Run(false, NodeInfo());
     return;
   }
 
+  if (!node_info_request_.AddCallback(std::move(callback)))
+    return;
+
   GURL gurl = server_endpoint_.Resolve(ipfs::kNodeInfoPath);
   auto url_loader = CreateURLLoader(gurl);
   auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
@@ -553,11 +584,10 @@ void IpfsService::GetNodeInfo(GetNodeInfoCallback callback) {
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
       base::BindOnce(&IpfsService::OnNodeInfo, base::Unretained(this),
-                     std::move(iter), std::move(callback)));
+                     std::move(iter)));
 }
 
 void IpfsService::OnNodeInfo(SimpleURLLoaderList::iterator iter,
-                             GetNodeInfoCallback callback,
                              std::unique_ptr<std::string> response_body) {
   auto* url_loader = iter->get();
   int error_code = url_loader->NetError();
@@ -570,13 +600,12 @@ void IpfsService::OnNodeInfo(SimpleURLLoaderList::iterator iter,
   if (error_code != net::OK || response_code != net::HTTP_OK) {
     VLOG(1) << "Fail to get node info, error_code = " << error_code
             << " response_code = " << response_code;
-    std::move(callback).Run(false, node_info);
-    return;
   }
 
   bool success =
+      error_code == net::OK && response_code == net::HTTP_OK &&
       IPFSJSONParser::GetNodeInfoFromJSON(*response_body, &node_info);
-  std::move(callback).Run(success, node_info);
+  node_info_request_.Complete(success, node_info);
 }
 
 void IpfsService::RunGarbageCollection(GarbageCollectionCallback callback) {
@@ -618,6 +647,8 @@ void IpfsService::OnGarbageCollection(
     const std::string& body = *response_body;
     if (!body.empty())
       IPFSJSONParser::GetGarbageCollectionFromJSON(body, &error);
+    // The repo shrank, so the cached stats are out of date.
+    repo_stats_request_.Invalidate();
   }
   std::move(callback).Run(success && error.empty(), error);
 }
@@ -17,6 +17,7 @@
 #include "base/observer_list.h"
 #include "brave/components/ipfs/addresses_config.h"
 #include "brave/components/ipfs/brave_ipfs_client_updater.h"
+#include "brave/components/ipfs/ipfs_coalesced_request.h"
 #include "brave/components/ipfs/ipfs_constants.h"
 #include "brave/components/ipfs/ipfs_p3a.h"
 #include "brave/components/ipfs/node_info.h"
@@ -134,19 +135,18 @@ class IpfsService : public KeyedService,
   base::TimeDelta CalculatePeersRetryTime();
   std::unique_ptr<network::SimpleURLLoader> CreateURLLoader(const GURL& gurl);
 
+  void RequestConnectedPeers(int retries);
   void OnGetConnectedPeers(SimpleURLLoaderList::iterator iter,
-                           GetConnectedPeersCallback,
                            int retries,
                            std::unique_ptr<std::string> response_body);
   void OnGetAddressesConfig(SimpleURLLoaderList::iterator iter,
-                            GetAddressesConfigCallback callback,
                             std::unique_ptr<std::string> response_body);
   void OnRepoStats(SimpleURLLoaderList::iterator iter,
-                   GetRepoStatsCallback callback,
                    std::unique_ptr<std::string> response_body);
   void OnNodeInfo(SimpleURLLoaderList::iterator iter,
-                  GetNodeInfoCallback callback,
                   std::unique_ptr<std::string> response_body);
+  // Drops cached daemon responses.
+  void InvalidateResponses();
   void OnGarbageCollection(SimpleURLLoaderList::iterator iter,
                            GarbageCollectionCallback callback,
                            std::unique_ptr<std::string> response_body);
@@ -164,6 +164,12 @@ class IpfsService : public KeyedService,
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   SimpleURLLoaderList url_loaders_;
 
+  // Concurrent requests for the same data share a single request.
+  CoalescedRequest<std::vector<std::string>> connected_peers_request_;
+  CoalescedRequest<AddressesConfig> addresses_config_request_;
+  CoalescedRequest<RepoStats> repo_stats_request_;
+  CoalescedRequest<NodeInfo> node_info_request_;
+
   base::queue<LaunchDaemonCallback> pending_launch_callbacks_;
 
   bool allow_ipfs_launch_for_test_ = false;
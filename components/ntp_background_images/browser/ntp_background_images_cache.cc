@@ -0,0 +1,113 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_background_images_cache.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/callback_helpers.h"
+#include "base/files/file_util.h"
+#include "base/task/post_task.h"
+
+namespace ntp_background_images {
+
+namespace {
+
+base::Optional<std::string> ReadFileToString(const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return base::Optional<std::string>();
+  return contents;
+}
+
+}  // namespace
+
+NTPBackgroundImagesCache::NTPBackgroundImagesCache(size_t max_bytes)
+    : max_bytes_(max_bytes), images_(decltype(images_)::NO_AUTO_EVICT) {}
+
+NTPBackgroundImagesCache::~NTPBackgroundImagesCache() = default;
+
+void NTPBackgroundImagesCache::GetImage(const base::FilePath& image_file_path,
+                                        GotImageCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  auto it = images_.Get(image_file_path);
+  if (it != images_.end()) {
+    std::move(callback).Run(it->second);
+    return;
+  }
+
+  auto& callbacks = pending_reads_[image_file_path];
+  callbacks.push_back(std::move(callback));
+  if (callbacks.size() > 1)
+    return;
+
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::ThreadPool(), base::MayBlock()},
+      base::BindOnce(&ReadFileToString, image_file_path),
+      base::BindOnce(&NTPBackgroundImagesCache::OnReadImageFile,
+                     weak_factory_.GetWeakPtr(), image_file_path,
+                     generation_));
+}
+
+void NTPBackgroundImagesCache::Preload(const base::FilePath& image_file_path) {
+  if (image_file_path.empty())
+    return;
+
+  GetImage(image_file_path, base::DoNothing());
+}
+
+void NTPBackgroundImagesCache::Clear() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  images_.Clear();
+  size_in_bytes_ = 0;
+  generation_++;
+}
+
+void NTPBackgroundImagesCache::OnReadImageFile(
+    const base::FilePath& image_file_path,
+    int generation,
+    base::Optional<std::string> contents) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  scoped_refptr<base::RefCountedMemory> bytes;
+  if (contents) {
+    bytes = base::RefCountedString::TakeString(&contents.value());
+    if (generation == generation_)
+      Put(image_file_path, bytes);
+  }
+
+  auto it = pending_reads_.find(image_file_path);
+  DCHECK(it != pending_reads_.end());
+  std::vector<GotImageCallback> callbacks = std::move(it->second);
+  pending_reads_.erase(it);
+
+  for (auto& callback : callbacks)
+    std::move(callback).Run(bytes);
+}
+
+void NTPBackgroundImagesCache::Put(
+    const base::FilePath& image_file_path,
+    scoped_refptr<base::RefCountedMemory> bytes) {
+  // An image which doesn't fit would only flush everything else.
+  if (bytes->size() > max_bytes_)
+    return;
+
+  DCHECK(images_.Peek(image_file_path) == images_.end());
+
+  size_in_bytes_ += bytes->size();
+  images_.Put(image_file_path, std::move(bytes));
+
+  while (size_in_bytes_ > max_bytes_) {
+    auto oldest = images_.rbegin();
+    DCHECK(oldest != images_.rend());
+    size_in_bytes_ -= oldest->second->size();
+    images_.Erase(oldest);
+  }
+}
+
+}  // namespace ntp_background_images
@@ -0,0 +1,81 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_CACHE_H_
+#define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "base/sequence_checker.h"
+
+namespace ntp_background_images {
+
+// Keeps the encoded bytes of recently served wallpapers, logos and top site
+// favicons in memory, so opening another new tab page doesn't read them from
+// disk again. Entries are keyed by file path, which includes the versioned
+// component install directory, and the least recently used entries are
+// evicted once |max_bytes| is exceeded.
+class NTPBackgroundImagesCache {
+ public:
+  using GotImageCallback =
+      base::OnceCallback<void(scoped_refptr<base::RefCountedMemory>)>;
+
+  // Room for a few full size wallpapers along with their logos.
+  static constexpr size_t kDefaultMaxBytes = 32 * 1024 * 1024;
+
+  explicit NTPBackgroundImagesCache(size_t max_bytes = kDefaultMaxBytes);
+  ~NTPBackgroundImagesCache();
+
+  NTPBackgroundImagesCache(const NTPBackgroundImagesCache&) = delete;
+  NTPBackgroundImagesCache& operator=(const NTPBackgroundImagesCache&) = delete;
+
+  // Runs |callback| with the contents of |image_file_path|, or with null if
+  // the file can't be read. Cached contents are returned synchronously.
+  // Otherwise the file is read on the thread pool, and concurrent requests for
+  // the same file share that read.
+  void GetImage(const base::FilePath& image_file_path,
+                GotImageCallback callback);
+
+  // Reads |image_file_path| into the cache ahead of a request for it.
+  void Preload(const base::FilePath& image_file_path);
+
+  // Drops all cached contents. Called when component data is updated. Reads
+  // which are in flight still run their callbacks, but aren't cached.
+  void Clear();
+
+  size_t size_in_bytes() const { return size_in_bytes_; }
+  size_t entry_count() const { return images_.size(); }
+
+ private:
+  void OnReadImageFile(const base::FilePath& image_file_path,
+                       int generation,
+                       base::Optional<std::string> contents);
+  void Put(const base::FilePath& image_file_path,
+           scoped_refptr<base::RefCountedMemory> bytes);
+
+  const size_t max_bytes_;
+  size_t size_in_bytes_ = 0;
+  // Incremented by |Clear| so that reads started before it aren't cached.
+  int generation_ = 0;
+  base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>
+      images_;
+  std::map<base::FilePath, std::vector<GotImageCallback>> pending_reads_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<NTPBackgroundImagesCache> weak_factory_{this};
+};
+
+}  // namespace ntp_background_images
+
+#endif  // BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_CACHE_H_
@@ -0,0 +1,147 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_background_images_cache.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ntp_background_images {
+
+namespace {
+
+void SaveImage(int* call_count,
+               std::string* image,
+               scoped_refptr<base::RefCountedMemory> bytes) {
+  (*call_count)++;
+  *image = bytes ? std::string(bytes->front_as<char>(), bytes->size())
+                 : "<null>";
+}
+
+}  // namespace
+
+class NTPBackgroundImagesCacheTest : public testing::Test {
+ public:
+  NTPBackgroundImagesCacheTest() {}
+
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath WriteImage(const std::string& name,
+                            const std::string& contents) {
+    const base::FilePath path = temp_dir_.GetPath().AppendASCII(name);
+    EXPECT_TRUE(base::WriteFile(path, contents));
+    return path;
+  }
+
+  std::string GetImage(NTPBackgroundImagesCache* cache,
+                       const base::FilePath& path) {
+    int call_count = 0;
+    std::string image;
+    cache->GetImage(path, base::BindOnce(&SaveImage, &call_count, &image));
+    task_environment_.RunUntilIdle();
+    EXPECT_EQ(1, call_count);
+    return image;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(NTPBackgroundImagesCacheTest, ServesCachedImageSynchronously) {
+  NTPBackgroundImagesCache cache;
+  const base::FilePath path = WriteImage("wallpaper-0.jpg", "wallpaper");
+  EXPECT_EQ("wallpaper", GetImage(&cache, path));
+  EXPECT_EQ(1u, cache.entry_count());
+  EXPECT_EQ(9u, cache.size_in_bytes());
+
+  // Changes on disk aren't seen, as the contents come from memory now.
+  WriteImage("wallpaper-0.jpg", "changed");
+  int call_count = 0;
+  std::string image;
+  cache.GetImage(path, base::BindOnce(&SaveImage, &call_count, &image));
+  EXPECT_EQ(1, call_count);
+  EXPECT_EQ("wallpaper", image);
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, MissingFileIsNotCached) {
+  NTPBackgroundImagesCache cache;
+  const base::FilePath path = temp_dir_.GetPath().AppendASCII("missing.jpg");
+  EXPECT_EQ("<null>", GetImage(&cache, path));
+  EXPECT_EQ(0u, cache.entry_count());
+
+  WriteImage("missing.jpg", "wallpaper");
+  EXPECT_EQ("wallpaper", GetImage(&cache, path));
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, ConcurrentRequestsShareRead) {
+  NTPBackgroundImagesCache cache;
+  const base::FilePath path = WriteImage("logo.png", "logo");
+
+  int call_count = 0;
+  std::string first;
+  std::string second;
+  cache.GetImage(path, base::BindOnce(&SaveImage, &call_count, &first));
+  cache.Preload(path);
+  cache.GetImage(path, base::BindOnce(&SaveImage, &call_count, &second));
+  EXPECT_EQ(0, call_count);
+
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(2, call_count);
+  EXPECT_EQ("logo", first);
+  EXPECT_EQ("logo", second);
+  EXPECT_EQ(1u, cache.entry_count());
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, EvictsLeastRecentlyUsed) {
+  NTPBackgroundImagesCache cache(10);
+  const base::FilePath a = WriteImage("a.jpg", "aaaa");
+  const base::FilePath b = WriteImage("b.jpg", "bbbb");
+  const base::FilePath c = WriteImage("c.jpg", "cccc");
+  const base::FilePath big = WriteImage("big.jpg", "bbbbbbbbbbbb");
+
+  GetImage(&cache, a);
+  GetImage(&cache, b);
+  // Touching |a| makes |b| the least recently used image.
+  GetImage(&cache, a);
+  GetImage(&cache, c);
+  EXPECT_EQ(2u, cache.entry_count());
+  EXPECT_EQ(8u, cache.size_in_bytes());
+
+  WriteImage("a.jpg", "changed");
+  WriteImage("b.jpg", "changed");
+  EXPECT_EQ("aaaa", GetImage(&cache, a));
+  EXPECT_EQ("changed", GetImage(&cache, b));
+
+  // Images over the budget are served but not cached.
+  EXPECT_EQ("bbbbbbbbbbbb", GetImage(&cache, big));
+  EXPECT_LE(cache.size_in_bytes(), 10u);
+  EXPECT_EQ(1u, cache.entry_count());
+}
+
+TEST_F(NTPBackgroundImagesCacheTest, ClearDropsImagesAndReadsInFlight) {
+  NTPBackgroundImagesCache cache;
+  const base::FilePath a = WriteImage("a.jpg", "aaaa");
+  const base::FilePath b = WriteImage("b.jpg", "bbbb");
+  GetImage(&cache, a);
+
+  int call_count = 0;
+  std::string image;
+  cache.GetImage(b, base::BindOnce(&SaveImage, &call_count, &image));
+  cache.Clear();
+  EXPECT_EQ(0u, cache.entry_count());
+  EXPECT_EQ(0u, cache.size_in_bytes());
+
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(1, call_count);
+  EXPECT_EQ("bbbb", image);
+  EXPECT_EQ(0u, cache.entry_count());
+}
+
+}  // namespace ntp_background_images
@@ -463,6 +463,9 @@ void NTPBackgroundImagesService::OnGetComponentJsonData(
                                                       si_installed_dir_));
   }
 
+  // Images of the previous component version aren't going to be shown again.
+  image_cache_.Clear();
+
   if (is_super_referral && !sr_images_data_->IsValid()) {
     DVLOG(2) << __func__ << ": NTP SR campaign ends.";
     UnRegisterSuperReferralComponent();
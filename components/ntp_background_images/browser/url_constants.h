@@ -40,6 +40,7 @@ constexpr char kWallpaperIDKey[] = "wallpaperId";
 
 constexpr char kIsSponsoredKey[] = "isSponsored";
 constexpr char kWallpaperImageURLKey[] = "wallpaperImageUrl";
+constexpr char kNextWallpaperImageURLKey[] = "nextWallpaperImageUrl";
 constexpr char kWallpaperImagePathKey[] = "wallpaperImagePath";
 constexpr char kWallpaperFocalPointXKey[] = "wallpaperFocalPointX";
 constexpr char kWallpaperFocalPointYKey[] = "wallpaperFocalPointY";
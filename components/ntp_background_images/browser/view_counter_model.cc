@@ -23,6 +23,17 @@ bool ViewCounterModel::ShouldShowBrandedWallpaper() const {
   return count_to_branded_wallpaper_ == 0;
 }
 
+int ViewCounterModel::GetNextWallpaperImageIndex() const {
+  if (total_image_count_ <= 0)
+    return current_wallpaper_image_index_;
+
+  // The index only moves on once the current image has been shown.
+  if (!ShouldShowBrandedWallpaper())
+    return current_wallpaper_image_index_;
+
+  return (current_wallpaper_image_index_ + 1) % total_image_count_;
+}
+
 void ViewCounterModel::ResetCurrentWallpaperImageIndex() {
   current_wallpaper_image_index_ = 0;
 }
@@ -28,6 +28,9 @@ class ViewCounterModel {
   }
 
   bool ShouldShowBrandedWallpaper() const;
+  // Index of the wallpaper which the branded view after the current one is
+  // going to show.
+  int GetNextWallpaperImageIndex() const;
   void RegisterPageView();
   void ResetCurrentWallpaperImageIndex();
 
@@ -27,12 +27,14 @@ TEST(ViewCounterModelTest, NTPSponsoredImagesTest) {
   // Image at index 0 should be displayed now after loading initial count.
   EXPECT_TRUE(model.ShouldShowBrandedWallpaper());
   EXPECT_EQ(0, model.current_wallpaper_image_index());
+  EXPECT_EQ(1, model.GetNextWallpaperImageIndex());
   model.RegisterPageView();
 
   // Loading regular-count times.
   for (int i = 0; i < ViewCounterModel::kRegularCountToBrandedWallpaper; ++i) {
     EXPECT_FALSE(model.ShouldShowBrandedWallpaper());
     EXPECT_EQ(1, model.current_wallpaper_image_index());
+    EXPECT_EQ(1, model.GetNextWallpaperImageIndex());
     model.RegisterPageView();
   }
 
@@ -51,6 +53,7 @@ TEST(ViewCounterModelTest, NTPSponsoredImagesTest) {
   // Image at index 2 should be displayed now.
   EXPECT_TRUE(model.ShouldShowBrandedWallpaper());
   EXPECT_EQ(2, model.current_wallpaper_image_index());
+  EXPECT_EQ(0, model.GetNextWallpaperImageIndex());
   model.RegisterPageView();
 
   // Loading regular-count times again.
@@ -76,6 +79,7 @@ TEST(ViewCounterModelTest, NTPSuperReferralTest) {
   for (int i = 0; i < 10; ++i) {
     EXPECT_TRUE(model.ShouldShowBrandedWallpaper());
     EXPECT_EQ(i % kTestImageCount, model.current_wallpaper_image_index());
+    EXPECT_EQ((i + 1) % kTestImageCount, model.GetNextWallpaperImageIndex());
     model.RegisterPageView();
   }
 }
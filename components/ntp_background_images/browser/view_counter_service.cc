@@ -19,6 +19,7 @@
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
 #include "brave/components/brave_rewards/common/pref_names.h"
 #include "brave/components/ntp_background_images/browser/features.h"
+#include "brave/components/ntp_background_images/browser/ntp_background_images_cache.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
 #include "brave/components/ntp_background_images/browser/url_constants.h"
 #include "brave/components/ntp_background_images/common/pref_names.h"
@@ -133,6 +134,15 @@ base::Value ViewCounterService::GetCurrentWallpaper() const {
   return base::Value();
 }
 
+base::Value ViewCounterService::GetNextWallpaper() const {
+  if (GetCurrentBrandedWallpaperData()) {
+    return GetCurrentBrandedWallpaperData()->GetBackgroundAt(
+        model_.GetNextWallpaperImageIndex());
+  }
+
+  return base::Value();
+}
+
 std::vector<TopSite> ViewCounterService::GetTopSitesVectorForWebUI() const {
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
   if (auto* data = GetCurrentBrandedWallpaperData()) {
@@ -217,7 +227,24 @@ void ViewCounterService::RegisterPageView() {
   // or the user opt-in status changing.
   if (IsBrandedWallpaperActive()) {
     model_.RegisterPageView();
+    // The model now points at the wallpaper of the next branded view, so have
+    // it in memory by the time that new tab page asks for it.
+    PreloadWallpaper(model_.current_wallpaper_image_index());
+  }
+}
+
+void ViewCounterService::PreloadWallpaper(int index) {
+  auto* data = GetCurrentBrandedWallpaperData();
+  if (!data || index < 0 ||
+      index >= static_cast<int>(data->backgrounds.size())) {
+    return;
   }
+
+  const Background& background = data->backgrounds[index];
+  service_->image_cache()->Preload(background.image_file);
+  service_->image_cache()->Preload(background.logo
+                                       ? background.logo->image_file
+                                       : data->default_logo.image_file);
 }
 
 void ViewCounterService::BrandedWallpaperLogoClicked(
@@ -61,6 +61,9 @@ class ViewCounterService : public KeyedService,
 
   base::Value GetCurrentWallpaperForDisplay() const;
   base::Value GetCurrentWallpaper() const;
+  // The wallpaper shown by the branded view after the current one, so that
+  // the new tab page can warm it up.
+  base::Value GetNextWallpaper() const;
   std::vector<TopSite> GetTopSitesVectorForWebUI() const;
   std::vector<TopSite> GetTopSitesVectorData() const;
 
@@ -120,6 +123,9 @@ class ViewCounterService : public KeyedService,
 
   void ResetModel();
 
+  // Reads the wallpaper at |index| and its logo into the image cache.
+  void PreloadWallpaper(int index);
+
   void UpdateP3AValues() const;
 
   NTPBackgroundImagesService* service_ = nullptr;  // not owned
@@ -5,8 +5,12 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include <algorithm>
+
+#include "base/base64.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/pickle.h"
 #include "base/rand_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
@@ -22,6 +26,14 @@ constexpr char kLogValueKey[] = "value";
 constexpr char kLogSentKey[] = "sent";
 constexpr char kLogTimestampKey[] = "timestamp";
 
+// Base64 encoded pickle of all log entries, replaces |kPrefName|.
+constexpr char kCompactPrefName[] = "p3a.compact_logs";
+constexpr int kCompactLogVersion = 1;
+
+// Value updates arrive in bursts (i.e. on startup), so persist them at most
+// once per this interval.
+constexpr base::TimeDelta kPersistDelay = base::TimeDelta::FromSeconds(30);
+
 void RecordP3A(uint64_t answers_count) {
   int answer = 0;
   if (1 <= answers_count && answers_count < 5) {
@@ -34,6 +46,14 @@ void RecordP3A(uint64_t answers_count) {
   UMA_HISTOGRAM_EXACT_LINEAR("Brave.P3A.SentAnswersCount", answer, 3);
 }
 
+std::string GetLogType(base::StringPiece histogram_name) {
+  if (base::StartsWith(histogram_name, "Brave.P2A",
+                       base::CompareCase::SENSITIVE)) {
+    return "p2a";
+  }
+  return "p3a";
+}
+
 }  // namespace
 
 BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
@@ -43,57 +63,59 @@ BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
   DCHECK(local_state);
 }
 
-BraveP3ALogStore::~BraveP3ALogStore() = default;
+BraveP3ALogStore::~BraveP3ALogStore() {
+  PersistPendingUpdates();
+}
 
 void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterDictionaryPref(kPrefName);
+  registry->RegisterStringPref(kCompactPrefName, std::string());
 }
 
 void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
                                    uint64_t value) {
   LogEntry& entry = log_[histogram_name];
+  if (entry.value == value &&
+      (entry.sent || unsent_entries_.contains(histogram_name))) {
+    // Nothing changed, avoid touching the persistent value.
+    return;
+  }
+
   entry.value = value;
   if (!entry.sent) {
     DCHECK(entry.sent_timestamp.is_null());
     unsent_entries_.insert(histogram_name);
   }
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  SchedulePersist();
 }
 
 void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
   DCHECK(delegate_->IsActualMetric(histogram_name));
-  log_.erase(histogram_name);
+  if (log_.erase(histogram_name) == 0) {
+    return;
+  }
   unsent_entries_.erase(histogram_name);
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->RemovePath(histogram_name);
+  SchedulePersist();
 
-  if (has_staged_log() && staged_entry_key_ == histogram_name) {
-    staged_entry_key_.clear();
-    staged_log_.clear();
+  auto iter = std::find(staged_entry_keys_.begin(), staged_entry_keys_.end(),
+                        histogram_name);
+  if (iter != staged_entry_keys_.end()) {
+    staged_logs_.erase(staged_logs_.begin() +
+                       (iter - staged_entry_keys_.begin()));
+    staged_entry_keys_.erase(iter);
   }
 }
 
 void BraveP3ALogStore::ResetUploadStamps() {
   // Clear log entries flags.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
   for (auto& pair : log_) {
     if (pair.second.sent) {
       DCHECK(!pair.second.sent_timestamp.is_null());
       DCHECK(!unsent_entries_.contains(pair.first));
 
       pair.second.ResetSentState();
-
-      // Update persistent values.
-      update->SetPath({pair.first, kLogSentKey}, base::Value(pair.second.sent));
-      update->SetPath({pair.first, kLogTimestampKey},
-                      base::Value(pair.second.sent_timestamp.ToDoubleT()));
     }
   }
 
@@ -104,6 +126,60 @@ void BraveP3ALogStore::ResetUploadStamps() {
   for (const auto& pair : log_) {
     unsent_entries_.insert(pair.first);
   }
+
+  PersistNow();
+}
+
+void BraveP3ALogStore::StageNextLogs(size_t max_count) {
+  DCHECK(has_unsent_logs());
+  DCHECK_GT(max_count, 0u);
+
+  // The log type of a randomly chosen entry selects the batch, so both types
+  // are staged with the same probability as when staging single entries.
+  const uint64_t rand_idx = base::RandGenerator(unsent_entries_.size());
+  const std::string& first_key = *(unsent_entries_.begin() + rand_idx);
+  const std::string log_type = GetLogType(first_key);
+
+  std::vector<std::string> keys;
+  keys.push_back(first_key);
+  if (max_count > 1) {
+    std::vector<std::string> candidates;
+    for (const auto& key : unsent_entries_) {
+      if (key != first_key && GetLogType(key) == log_type) {
+        candidates.push_back(key);
+      }
+    }
+    base::RandomShuffle(candidates.begin(), candidates.end());
+    if (candidates.size() > max_count - 1) {
+      candidates.resize(max_count - 1);
+    }
+    keys.insert(keys.end(), candidates.begin(), candidates.end());
+    base::RandomShuffle(keys.begin(), keys.end());
+  }
+
+  staged_entry_keys_ = keys;
+  staged_logs_.clear();
+  for (const auto& key : staged_entry_keys_) {
+    DCHECK(!log_.find(key)->second.sent);
+    staged_logs_.push_back(delegate_->Serialize(key, log_[key].value));
+    VLOG(2) << "BraveP3ALogStore::StageNextLogs: staged " << key;
+  }
+}
+
+const std::vector<std::string>& BraveP3ALogStore::staged_logs() const {
+  DCHECK(has_staged_log());
+  return staged_logs_;
+}
+
+void BraveP3ALogStore::PersistNow() {
+  persist_timer_.Stop();
+  local_state_->SetString(kCompactPrefName, SerializeLog());
+}
+
+void BraveP3ALogStore::PersistPendingUpdates() {
+  if (persist_timer_.IsRunning()) {
+    PersistNow();
+  }
 }
 
 bool BraveP3ALogStore::has_unsent_logs() const {
@@ -111,27 +187,21 @@ bool BraveP3ALogStore::has_unsent_logs() const {
 }
 
 bool BraveP3ALogStore::has_staged_log() const {
-  return !staged_entry_key_.empty();
+  return !staged_entry_keys_.empty();
 }
 
 const std::string& BraveP3ALogStore::staged_log() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
+  DCHECK(has_staged_log());
+  DCHECK(log_.find(staged_entry_keys_.front()) != log_.end());
 
-  return staged_log_;
+  return staged_logs_.front();
 }
 
 std::string BraveP3ALogStore::staged_log_type() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
+  DCHECK(has_staged_log());
+  DCHECK(log_.find(staged_entry_keys_.front()) != log_.end());
 
-  if (base::StartsWith(iter->first, "Brave.P2A",
-                       base::CompareCase::SENSITIVE)) {
-    return "p2a";
-  }
-  return "p3a";
+  return GetLogType(staged_entry_keys_.front());
 }
 
 const std::string& BraveP3ALogStore::staged_log_hash() const {
@@ -145,16 +215,7 @@ const std::string& BraveP3ALogStore::staged_log_signature() const {
 }
 
 void BraveP3ALogStore::StageNextLog() {
-  // Stage the next item.
-  DCHECK(has_unsent_logs());
-  uint64_t rand_idx = base::RandGenerator(unsent_entries_.size());
-  staged_entry_key_ = *(unsent_entries_.begin() + rand_idx);
-  DCHECK(!log_.find(staged_entry_key_)->second.sent);
-
-  uint64_t staged_entry_value = log_[staged_entry_key_].value;
-  staged_log_ = delegate_->Serialize(staged_entry_key_, staged_entry_value);
-
-  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << staged_entry_key_;
+  StageNextLogs(1);
 }
 
 void BraveP3ALogStore::DiscardStagedLog() {
@@ -162,25 +223,23 @@ void BraveP3ALogStore::DiscardStagedLog() {
     return;
   }
 
-  // Mark previous staged log as sent.
-  auto log_iter = log_.find(staged_entry_key_);
-  DCHECK(log_iter != log_.end());
-  log_iter->second.MarkAsSent();
+  for (const auto& key : staged_entry_keys_) {
+    // Mark previous staged log as sent.
+    auto log_iter = log_.find(key);
+    DCHECK(log_iter != log_.end());
+    log_iter->second.MarkAsSent();
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
+    // Erase the entry from the unsent queue.
+    auto unsent_entries_iter = unsent_entries_.find(key);
+    DCHECK(unsent_entries_iter != unsent_entries_.end());
+    unsent_entries_.erase(unsent_entries_iter);
+  }
 
-  // Erase the entry from the unsent queue.
-  auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
-  DCHECK(unsent_entries_iter != unsent_entries_.end());
-  unsent_entries_.erase(unsent_entries_iter);
+  staged_entry_keys_.clear();
+  staged_logs_.clear();
 
-  staged_entry_key_.clear();
-  staged_log_.clear();
+  // Update the persistent value.
+  PersistNow();
 }
 
 void BraveP3ALogStore::MarkStagedLogAsSent() {}
@@ -193,15 +252,114 @@ void BraveP3ALogStore::LoadPersistedUnsentLogs() {
   DCHECK(log_.empty());
   DCHECK(unsent_entries_.empty());
 
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  base::DictionaryValue* list = update.Get();
+  if (!local_state_->GetDictionary(kPrefName)->empty()) {
+    LoadLegacyLog();
+    local_state_->ClearPref(kPrefName);
+    PersistNow();
+    return;
+  }
+
+  if (!DeserializeLog(local_state_->GetString(kCompactPrefName))) {
+    log_.clear();
+    unsent_entries_.clear();
+    return;
+  }
+
+  // Drop obsolete metrics from the local state.
+  bool has_obsolete_metrics = false;
+  for (auto iter = log_.begin(); iter != log_.end();) {
+    if (delegate_->IsActualMetric(iter->first)) {
+      if (!iter->second.sent) {
+        unsent_entries_.insert(iter->first);
+      }
+      ++iter;
+    } else {
+      iter = log_.erase(iter);
+      has_obsolete_metrics = true;
+    }
+  }
+
+  if (has_obsolete_metrics) {
+    PersistNow();
+  }
+}
+
+void BraveP3ALogStore::SchedulePersist() {
+  if (persist_timer_.IsRunning()) {
+    return;
+  }
+
+  persist_timer_.Start(FROM_HERE, kPersistDelay, this,
+                       &BraveP3ALogStore::PersistNow);
+}
+
+std::string BraveP3ALogStore::SerializeLog() const {
+  base::Pickle pickle;
+  pickle.WriteInt(kCompactLogVersion);
+  pickle.WriteUInt64(log_.size());
+  for (const auto& pair : log_) {
+    pickle.WriteString(pair.first);
+    pickle.WriteUInt64(pair.second.value);
+    pickle.WriteBool(pair.second.sent);
+    pickle.WriteDouble(pair.second.sent_timestamp.ToDoubleT());
+  }
+
+  std::string encoded;
+  base::Base64Encode(
+      base::StringPiece(static_cast<const char*>(pickle.data()), pickle.size()),
+      &encoded);
+  return encoded;
+}
+
+bool BraveP3ALogStore::DeserializeLog(const std::string& data) {
+  if (data.empty()) {
+    return true;
+  }
+
+  std::string decoded;
+  if (!base::Base64Decode(data, &decoded)) {
+    return false;
+  }
+
+  base::Pickle pickle(decoded.data(), decoded.size());
+  base::PickleIterator iter(pickle);
+
+  int version = 0;
+  uint64_t count = 0;
+  if (!iter.ReadInt(&version) || version != kCompactLogVersion ||
+      !iter.ReadUInt64(&count)) {
+    return false;
+  }
+
+  for (uint64_t i = 0; i < count; i++) {
+    std::string name;
+    LogEntry entry;
+    double timestamp = 0.0;
+    if (!iter.ReadString(&name) || !iter.ReadUInt64(&entry.value) ||
+        !iter.ReadBool(&entry.sent) || !iter.ReadDouble(&timestamp)) {
+      return false;
+    }
+
+    entry.sent_timestamp = base::Time::FromDoubleT(timestamp);
+    if (entry.sent == entry.sent_timestamp.is_null()) {
+      return false;
+    }
+
+    log_[name] = entry;
+  }
+
+  return true;
+}
+
+void BraveP3ALogStore::LoadLegacyLog() {
+  // The legacy pref is cleared once migrated, so only malformed entries are
+  // skipped.
+  const base::DictionaryValue* list = local_state_->GetDictionary(kPrefName);
   for (auto dict_item : list->DictItems()) {
     LogEntry entry;
     const std::string name = dict_item.first;
     // Check if the metric is obsolete.
     if (!delegate_->IsActualMetric(name)) {
-      // Drop it from the local state.
-      list->RemoveKey(name);
       continue;
     }
     const base::Value& dict = dict_item.second;
@@ -209,10 +367,10 @@ void BraveP3ALogStore::LoadPersistedUnsentLogs() {
     if (const base::Value* v =
             dict.FindKeyOfType(kLogValueKey, base::Value::Type::STRING)) {
       if (!base::StringToUint64(v->GetString(), &entry.value)) {
-        return;
+        continue;
       }
     } else {
-      return;
+      continue;
     }
 
     // Sent flag.
@@ -220,7 +378,7 @@ void BraveP3ALogStore::LoadPersistedUnsentLogs() {
             dict.FindKeyOfType(kLogSentKey, base::Value::Type::BOOLEAN)) {
       entry.sent = v->GetBool();
     } else {
-      return;
+      continue;
     }
 
     // Timestamp.
@@ -229,7 +387,7 @@ void BraveP3ALogStore::LoadPersistedUnsentLogs() {
       entry.sent_timestamp = base::Time::FromDoubleT(v->GetDouble());
       if ((entry.sent && entry.sent_timestamp.is_null()) ||
           (!entry.sent && !entry.sent_timestamp.is_null())) {
-        return;
+        continue;
       }
     } else {
       // Sometimes we do not persist empty timestamps, so it is ok.
@@ -7,11 +7,13 @@
 #define BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_STORE_H_
 
 #include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/metrics/log_store.h"
 
 class PrefService;
@@ -19,7 +21,12 @@ class PrefRegistrySimple;
 
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
+// Stores all given values in memory and persists them in prefs as a single
+// compact binary blob. Changes to sent state are persisted immediately so that
+// a value is never resent after a restart, while value updates are coalesced
+// and persisted after a delay. Updates which are still waiting for it are
+// persisted on shutdown, since histograms recorded on events only are not
+// reported again on the next run.
 // All logs (not only unsent are persistent), and all logs could be loaded
 // using |LoadPersistedUnsentLogs()|. We should fix this at some point since
 // for now persisted entries never expire.
@@ -49,6 +56,17 @@ class BraveP3ALogStore : public metrics::LogStore {
   // Marks all saved values as unsent.
   void ResetUploadStamps();
 
+  // Stages up to |max_count| randomly chosen unsent values of the same log
+  // type (P3A or P2A) in a random order.
+  void StageNextLogs(size_t max_count);
+  // Serialized staged values, |staged_log()| is the first of them.
+  const std::vector<std::string>& staged_logs() const;
+
+  // Persists pending value updates right away.
+  void PersistNow();
+  // Persists value updates if any are waiting for the coalescing delay.
+  void PersistPendingUpdates();
+
   // metrics::LogStore:
   bool has_unsent_logs() const override;
   bool has_staged_log() const override;
@@ -84,6 +102,13 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  void SchedulePersist();
+
+  std::string SerializeLog() const;
+  bool DeserializeLog(const std::string& data);
+  // Loads entries from the dictionary format used before the compact one.
+  void LoadLegacyLog();
+
   Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
 
@@ -91,8 +116,10 @@ class BraveP3ALogStore : public metrics::LogStore {
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
 
-  std::string staged_entry_key_;
-  std::string staged_log_;
+  std::vector<std::string> staged_entry_keys_;
+  std::vector<std::string> staged_logs_;
+
+  base::OneShotTimer persist_timer_;
 
   // Not used for now.
   std::string staged_log_hash_;
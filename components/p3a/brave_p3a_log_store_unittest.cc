@@ -0,0 +1,240 @@
+// Copyright (c) 2020 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/values.h"
+#include "components/prefs/pref_change_registrar.h"
+#include "components/prefs/scoped_user_pref_update.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=P3ALogStore*
+
+namespace brave {
+
+namespace {
+
+constexpr char kLegacyPrefName[] = "p3a.logs";
+constexpr char kCompactPrefName[] = "p3a.compact_logs";
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) override {
+    return histogram_name.as_string() + ":" + base::NumberToString(value);
+  }
+
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return histogram_name != "Brave.Obsolete";
+  }
+};
+
+}  // namespace
+
+class P3ALogStoreTest : public testing::Test {
+ protected:
+  P3ALogStoreTest() {
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+
+    registrar_.Init(&local_state_);
+    registrar_.Add(kCompactPrefName,
+                   base::BindRepeating(&P3ALogStoreTest::OnLogPersisted,
+                                       base::Unretained(this)));
+  }
+
+  std::unique_ptr<BraveP3ALogStore> CreateLogStore() {
+    auto log_store =
+        std::make_unique<BraveP3ALogStore>(&delegate_, &local_state_);
+    log_store->LoadPersistedUnsentLogs();
+    return log_store;
+  }
+
+  void OnLogPersisted() { persist_count_++; }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  TestingPrefServiceSimple local_state_;
+  PrefChangeRegistrar registrar_;
+  TestDelegate delegate_;
+  size_t persist_count_ = 0;
+};
+
+TEST_F(P3ALogStoreTest, PersistsSentStateImmediately) {
+  auto log_store = CreateLogStore();
+  log_store->UpdateValue("Brave.Core.TabCount", 1);
+  log_store->UpdateValue("Brave.Core.WindowCount.2", 2);
+
+  log_store->StageNextLog();
+  const std::string staged_log = log_store->staged_log();
+  log_store->DiscardStagedLog();
+  EXPECT_EQ(1u, persist_count_);
+
+  // A new log store loads the sent state without waiting for the timer.
+  auto loaded_log_store = CreateLogStore();
+  ASSERT_TRUE(loaded_log_store->has_unsent_logs());
+  loaded_log_store->StageNextLog();
+  EXPECT_NE(staged_log, loaded_log_store->staged_log());
+  loaded_log_store->DiscardStagedLog();
+  EXPECT_FALSE(loaded_log_store->has_unsent_logs());
+}
+
+TEST_F(P3ALogStoreTest, CoalescesValueUpdates) {
+  auto log_store = CreateLogStore();
+  for (uint64_t i = 0; i < 10; i++) {
+    log_store->UpdateValue("Brave.Core.TabCount", i);
+    log_store->UpdateValue("Brave.Core.WindowCount.2", i);
+  }
+  EXPECT_EQ(0u, persist_count_);
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(1u, persist_count_);
+
+  // Unchanged values are not persisted again.
+  log_store->UpdateValue("Brave.Core.TabCount", 9);
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(1u, persist_count_);
+}
+
+TEST_F(P3ALogStoreTest, PersistsPendingUpdatesOnDestruction) {
+  auto log_store = CreateLogStore();
+  log_store->UpdateValue("Brave.Core.TabCount", 3);
+  log_store->PersistPendingUpdates();
+  EXPECT_EQ(1u, persist_count_);
+
+  // Nothing is pending, so nothing is written again.
+  log_store->PersistPendingUpdates();
+  EXPECT_EQ(1u, persist_count_);
+
+  log_store->UpdateValue("Brave.Core.TabCount", 4);
+  log_store.reset();
+  EXPECT_EQ(2u, persist_count_);
+
+  auto loaded_log_store = CreateLogStore();
+  ASSERT_TRUE(loaded_log_store->has_unsent_logs());
+  loaded_log_store->StageNextLog();
+  EXPECT_EQ("Brave.Core.TabCount:4", loaded_log_store->staged_log());
+}
+
+TEST_F(P3ALogStoreTest, SimulatedWeek) {
+  const size_t kMetricCount = 20;
+  const size_t kMinutesPerWeek = 7 * 24 * 60;
+
+  auto log_store = CreateLogStore();
+
+  size_t update_count = 0;
+  size_t upload_count = 0;
+  for (size_t minute = 0; minute < kMinutesPerWeek; minute++) {
+    for (size_t i = 0; i < kMetricCount; i++) {
+      log_store->UpdateValue("Brave.Metric" + base::NumberToString(i),
+                             minute % 7);
+      update_count++;
+    }
+
+    if (log_store->has_unsent_logs()) {
+      log_store->StageNextLogs(5);
+      log_store->DiscardStagedLog();
+      upload_count++;
+    }
+
+    task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  }
+
+  // Each value update used to rewrite the pref, now there is at most one
+  // coalesced write and one sent state write per minute.
+  EXPECT_EQ(kMetricCount * kMinutesPerWeek, update_count);
+  EXPECT_LE(persist_count_, 2 * kMinutesPerWeek);
+  // Values are only sent once per rotation, in batches of five.
+  EXPECT_EQ(kMetricCount / 5, upload_count);
+}
+
+TEST_F(P3ALogStoreTest, StagesBatchesOfTheSameType) {
+  auto log_store = CreateLogStore();
+  for (int i = 0; i < 4; i++) {
+    log_store->UpdateValue("Brave.P2A.Metric" + base::NumberToString(i), i);
+    log_store->UpdateValue("Brave.Core.Metric" + base::NumberToString(i), i);
+  }
+
+  size_t sent_count = 0;
+  while (log_store->has_unsent_logs()) {
+    log_store->StageNextLogs(3);
+    const std::string log_type = log_store->staged_log_type();
+    const std::vector<std::string>& logs = log_store->staged_logs();
+    ASSERT_LE(logs.size(), 3u);
+    for (const auto& log : logs) {
+      const bool is_p2a = log.find("Brave.P2A.") == 0;
+      EXPECT_EQ(log_type == "p2a", is_p2a);
+    }
+    sent_count += logs.size();
+    log_store->DiscardStagedLog();
+  }
+
+  EXPECT_EQ(8u, sent_count);
+}
+
+TEST_F(P3ALogStoreTest, RemoveStagedValue) {
+  auto log_store = CreateLogStore();
+  log_store->UpdateValue("Brave.Core.TabCount", 1);
+  log_store->UpdateValue("Brave.Core.WindowCount.2", 2);
+
+  log_store->StageNextLogs(2);
+  ASSERT_EQ(2u, log_store->staged_logs().size());
+
+  log_store->RemoveValueIfExists("Brave.Core.TabCount");
+  ASSERT_EQ(1u, log_store->staged_logs().size());
+  EXPECT_EQ("Brave.Core.WindowCount.2:2", log_store->staged_log());
+
+  log_store->DiscardStagedLog();
+  EXPECT_FALSE(log_store->has_unsent_logs());
+}
+
+TEST_F(P3ALogStoreTest, MigratesLegacyLog) {
+  {
+    DictionaryPrefUpdate update(&local_state_, kLegacyPrefName);
+    update->SetPath({"Brave.Core.TabCount", "value"}, base::Value("3"));
+    update->SetPath({"Brave.Core.TabCount", "sent"}, base::Value(false));
+    update->SetPath({"Brave.Obsolete", "value"}, base::Value("1"));
+    update->SetPath({"Brave.Obsolete", "sent"}, base::Value(false));
+  }
+
+  auto log_store = CreateLogStore();
+  EXPECT_TRUE(local_state_.GetDictionary(kLegacyPrefName)->empty());
+  EXPECT_FALSE(local_state_.GetString(kCompactPrefName).empty());
+
+  ASSERT_TRUE(log_store->has_unsent_logs());
+  log_store->StageNextLog();
+  EXPECT_EQ("Brave.Core.TabCount:3", log_store->staged_log());
+  log_store->DiscardStagedLog();
+  EXPECT_FALSE(log_store->has_unsent_logs());
+}
+
+TEST_F(P3ALogStoreTest, MigratesLegacyLogPastMalformedEntries) {
+  {
+    DictionaryPrefUpdate update(&local_state_, kLegacyPrefName);
+    // Sorts before the valid entry.
+    update->SetPath({"Brave.Core.Bookmarks", "value"}, base::Value("bad"));
+    update->SetPath({"Brave.Core.Bookmarks", "sent"}, base::Value(false));
+    update->SetPath({"Brave.Core.TabCount", "value"}, base::Value("3"));
+    update->SetPath({"Brave.Core.TabCount", "sent"}, base::Value(false));
+  }
+
+  auto log_store = CreateLogStore();
+  EXPECT_TRUE(local_state_.GetDictionary(kLegacyPrefName)->empty());
+
+  ASSERT_TRUE(log_store->has_unsent_logs());
+  log_store->StageNextLog();
+  EXPECT_EQ("Brave.Core.TabCount:3", log_store->staged_log());
+  log_store->DiscardStagedLog();
+  EXPECT_FALSE(log_store->has_unsent_logs());
+}
+
+}  // namespace brave
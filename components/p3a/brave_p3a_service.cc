@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/i18n/timezone.h"
@@ -234,6 +235,7 @@ void BraveP3AService::Init(
   VLOG(2) << "BraveP3AService parameters are:"
           << ", average_upload_interval_ = " << average_upload_interval_
           << ", randomize_upload_interval_ = " << randomize_upload_interval_
+          << ", upload_batch_size_ = " << upload_batch_size_
           << ", upload_server_url_ = " << upload_server_url_.spec()
           << ", rotation_interval_ = " << rotation_interval_;
 
@@ -280,6 +282,12 @@ void BraveP3AService::Init(
   }
 }
 
+void BraveP3AService::Shutdown() {
+  if (log_store_) {
+    log_store_->PersistPendingUpdates();
+  }
+}
+
 std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
                                        uint64_t value) {
   // TRACE_EVENT0("brave_p3a", "SerializeMessage");
@@ -325,6 +333,15 @@ void BraveP3AService::MaybeOverrideSettingsFromCommandLine() {
     randomize_upload_interval_ = false;
   }
 
+  if (cmdline->HasSwitch(switches::kP3AUploadBatchSize)) {
+    std::string batch_size_str =
+        cmdline->GetSwitchValueASCII(switches::kP3AUploadBatchSize);
+    size_t batch_size;
+    if (base::StringToSizeT(batch_size_str, &batch_size) && batch_size > 0) {
+      upload_batch_size_ = batch_size;
+    }
+  }
+
   if (cmdline->HasSwitch(switches::kP3ARotationIntervalSeconds)) {
     std::string seconds_str =
         cmdline->GetSwitchValueASCII(switches::kP3ARotationIntervalSeconds);
@@ -387,14 +404,22 @@ void BraveP3AService::StartScheduledUpload() {
     return;
   }
   if (!log_store_->has_staged_log()) {
-    log_store_->StageNextLog();
+    log_store_->StageNextLogs(upload_batch_size_);
   }
 
   // Only upload if service is enabled.
   bool p3a_enabled = local_state_->GetBoolean(brave::kP3AEnabled);
   if (p3a_enabled) {
-    const std::string log = log_store_->staged_log();
     const std::string log_type = log_store_->staged_log_type();
+    const std::vector<std::string>& logs = log_store_->staged_logs();
+    if (logs.size() > 1) {
+      VLOG(2) << "StartScheduledUpload - Uploading " << logs.size()
+              << " values of type " << log_type;
+      uploader_->UploadLogs(logs, log_type);
+      return;
+    }
+
+    const std::string log = log_store_->staged_log();
     VLOG(2) << "StartScheduledUpload - Uploading " << log.size() << " bytes "
             << "of type " << log_type;
     uploader_->UploadLog(log, log_type);
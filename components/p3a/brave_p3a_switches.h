@@ -22,6 +22,12 @@ constexpr char kP3ARotationIntervalSeconds[] = "p3a-rotation-interval-seconds";
 // P3A cloud backend URL.
 constexpr char kP3AUploadServerUrl[] = "p3a-upload-server-url";
 
+// Opt-in: send up to this many values of the same type, shuffled, in a single
+// upload instead of one value per upload. Values sent together can be linked
+// to each other by the server, so this should only be used with a backend
+// that does not log request level metadata.
+constexpr char kP3AUploadBatchSize[] = "p3a-upload-batch-size";
+
 // Do not try to resent values even if a cloud returned an HTTP error, just
 // continue the normal process.
 constexpr char kP3AIgnoreServerErrors[] = "p3a-ignore-server-errors";
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "base/base64.h"
+#include "base/strings/string_util.h"
 #include "net/base/load_flags.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
@@ -81,6 +82,25 @@ BraveP3AUploader::~BraveP3AUploader() = default;
 
 void BraveP3AUploader::UploadLog(const std::string& compressed_log_data,
                                  const std::string& upload_type) {
+  std::string base64;
+  base::Base64Encode(compressed_log_data, &base64);
+  Upload(base64, upload_type);
+}
+
+void BraveP3AUploader::UploadLogs(const std::vector<std::string>& logs,
+                                  const std::string& upload_type) {
+  std::vector<std::string> lines;
+  lines.reserve(logs.size());
+  for (const auto& log : logs) {
+    std::string base64;
+    base::Base64Encode(log, &base64);
+    lines.push_back(std::move(base64));
+  }
+  Upload(base::JoinString(lines, "\n"), upload_type);
+}
+
+void BraveP3AUploader::Upload(const std::string& base64_data,
+                              const std::string& upload_type) {
   auto resource_request = std::make_unique<network::ResourceRequest>();
   if (upload_type == "p2a") {
     resource_request->url = p2a_endpoint_;
@@ -98,9 +118,7 @@ void BraveP3AUploader::UploadLog(const std::string& compressed_log_data,
   url_loader_ = network::SimpleURLLoader::Create(
       std::move(resource_request),
       GetNetworkTrafficAnnotation(upload_type));
-  std::string base64;
-  base::Base64Encode(compressed_log_data, &base64);
-  url_loader_->AttachStringForUpload(base64, "application/base64");
+  url_loader_->AttachStringForUpload(base64_data, "application/base64");
 
   url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
@@ -36,9 +37,16 @@ class BraveP3AUploader {
   void UploadLog(const std::string& compressed_log_data,
                  const std::string& upload_type);
 
+  // Uploads several logs of the same type in one request, one base64 encoded
+  // log per line.
+  void UploadLogs(const std::vector<std::string>& logs,
+                  const std::string& upload_type);
+
   void OnUploadComplete(std::unique_ptr<std::string> response_body);
 
  private:
+  void Upload(const std::string& base64_data, const std::string& upload_type);
+
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   const GURL p3a_endpoint_;
   const GURL p2a_endpoint_;
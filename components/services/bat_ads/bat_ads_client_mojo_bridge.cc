@@ -27,8 +27,10 @@ ads::Result ToAdsResult(
 ///////////////////////////////////////////////////////////////////////////////
 
 BatAdsClientMojoBridge::BatAdsClientMojoBridge(
-    mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info) {
+    mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info,
+    mojo::PendingRemote<mojom::BatAdsDatabase> database) {
   bat_ads_client_.Bind(std::move(client_info));
+  bat_ads_database_.Bind(std::move(database));
 }
 
 BatAdsClientMojoBridge::~BatAdsClientMojoBridge() = default;
@@ -240,7 +242,7 @@ void OnRunDBTransaction(
 void BatAdsClientMojoBridge::RunDBTransaction(
     ads::DBTransactionPtr transaction,
     ads::RunDBTransactionCallback callback) {
-  bat_ads_client_->RunDBTransaction(std::move(transaction),
+  bat_ads_database_->RunTransaction(std::move(transaction),
       base::BindOnce(&OnRunDBTransaction, std::move(callback)));
 }
 
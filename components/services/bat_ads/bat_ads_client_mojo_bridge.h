@@ -14,14 +14,17 @@
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/remote.h"
 
 namespace bat_ads {
 
 class BatAdsClientMojoBridge
     : public ads::AdsClient {
  public:
-  explicit BatAdsClientMojoBridge(
-      mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info);
+  BatAdsClientMojoBridge(
+      mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info,
+      mojo::PendingRemote<mojom::BatAdsDatabase> database);
 
   ~BatAdsClientMojoBridge() override;
 
@@ -132,6 +135,10 @@ class BatAdsClientMojoBridge
   bool connected() const;
 
   mojo::AssociatedRemote<mojom::BatAdsClient> bat_ads_client_;
+
+  // Database transactions go straight to the browser sequence which owns the
+  // database, see |AdsDatabaseMojoBridge|
+  mojo::Remote<mojom::BatAdsDatabase> bat_ads_database_;
 };
 
 }  // namespace bat_ads
@@ -36,9 +36,10 @@ ads::CategoryContentInfo::OptAction ToAdsOptAction(
 }  // namespace
 
 BatAdsImpl::BatAdsImpl(
-    mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info) :
+    mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info,
+    mojo::PendingRemote<mojom::BatAdsDatabase> database) :
     bat_ads_client_mojo_proxy_(new BatAdsClientMojoBridge(
-        std::move(client_info))),
+        std::move(client_info), std::move(database))),
     ads_(ads::Ads::CreateInstance(bat_ads_client_mojo_proxy_.get())) {
 }
 
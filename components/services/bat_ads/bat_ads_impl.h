@@ -30,8 +30,9 @@ class BatAdsImpl :
     public mojom::BatAds,
     public base::SupportsWeakPtr<BatAdsImpl> {
  public:
-  explicit BatAdsImpl(
-      mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info);
+  BatAdsImpl(
+      mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info,
+      mojo::PendingRemote<mojom::BatAdsDatabase> database);
   ~BatAdsImpl() override;
 
   BatAdsImpl(const BatAdsImpl&) = delete;
@@ -15,6 +15,7 @@
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "mojo/public/cpp/bindings/unique_associated_receiver_set.h"
 
@@ -34,6 +35,7 @@ class BatAdsServiceImpl : public mojom::BatAdsService {
   void Create(
       mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info,
       mojo::PendingAssociatedReceiver<mojom::BatAds> bat_ads,
+      mojo::PendingRemote<mojom::BatAdsDatabase> database,
       CreateCallback callback) override;
 
   void SetEnvironment(
@@ -253,25 +253,6 @@ void AdsClientMojoBridge::CloseNotification(
 }
 
 // static
-void AdsClientMojoBridge::OnRunDBTransaction(
-    CallbackHolder<RunDBTransactionCallback>* holder,
-    ads::DBCommandResponsePtr response) {
-  DCHECK(holder);
-  if (holder->is_valid()) {
-    std::move(holder->get()).Run(std::move(response));
-  }
-  delete holder;
-}
-
-void AdsClientMojoBridge::RunDBTransaction(
-    ads::DBTransactionPtr transaction,
-    RunDBTransactionCallback callback) {
-  auto* holder = new CallbackHolder<RunDBTransactionCallback>(AsWeakPtr(),
-      std::move(callback));
-  ads_client_->RunDBTransaction(std::move(transaction),
-      std::bind(AdsClientMojoBridge::OnRunDBTransaction, holder, _1));
-}
-
 void AdsClientMojoBridge::OnAdRewardsChanged() {
   ads_client_->OnAdRewardsChanged();
 }
@@ -87,9 +87,6 @@ class AdsClientMojoBridge
       const std::string& json) override;
   void CloseNotification(
       const std::string& uuid) override;
-  void RunDBTransaction(
-      ads::DBTransactionPtr transaction,
-      RunDBTransactionCallback callback) override;
   void OnAdRewardsChanged() override;
 
   void GetBooleanPref(
@@ -179,10 +176,6 @@ class AdsClientMojoBridge
       CallbackHolder<UrlRequestCallback>* holder,
       const ads::UrlResponse& url_response);
 
-  static void OnRunDBTransaction(
-      CallbackHolder<RunDBTransactionCallback>* holder,
-      ads::DBCommandResponsePtr response);
-
   ads::AdsClient* ads_client_;  // NOT OWNED
 };
 
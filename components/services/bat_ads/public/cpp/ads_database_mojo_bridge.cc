@@ -0,0 +1,38 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ads/public/cpp/ads_database_mojo_bridge.h"
+
+#include <utility>
+
+namespace bat_ads {
+
+AdsDatabaseMojoBridge::AdsDatabaseMojoBridge(const base::FilePath& path)
+    : database_(path) {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+AdsDatabaseMojoBridge::~AdsDatabaseMojoBridge() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+void AdsDatabaseMojoBridge::Bind(
+    mojo::PendingReceiver<mojom::BatAdsDatabase> receiver) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  receiver_.Bind(std::move(receiver));
+}
+
+void AdsDatabaseMojoBridge::RunTransaction(
+    ads::DBTransactionPtr transaction,
+    RunTransactionCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  auto response = ads::DBCommandResponse::New();
+  database_.RunTransaction(std::move(transaction), response.get());
+  std::move(callback).Run(std::move(response));
+}
+
+}  // namespace bat_ads
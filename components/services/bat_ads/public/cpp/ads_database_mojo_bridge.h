@@ -0,0 +1,49 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SERVICES_BAT_ADS_PUBLIC_CPP_ADS_DATABASE_MOJO_BRIDGE_H_
+#define BRAVE_COMPONENTS_SERVICES_BAT_ADS_PUBLIC_CPP_ADS_DATABASE_MOJO_BRIDGE_H_
+
+#include "base/files/file_path.h"
+#include "base/sequence_checker.h"
+#include "bat/ads/database.h"
+#include "bat/ads/mojom.h"
+#include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+
+namespace bat_ads {
+
+// Owns the ads database and serves transactions from the bat ads service.
+// Created on any sequence, then bound and destroyed on the sequence which runs
+// the transactions, so the service talks to that sequence directly instead of
+// going through the ads service on the UI thread.
+class AdsDatabaseMojoBridge : public mojom::BatAdsDatabase {
+ public:
+  explicit AdsDatabaseMojoBridge(const base::FilePath& path);
+
+  ~AdsDatabaseMojoBridge() override;
+
+  AdsDatabaseMojoBridge(const AdsDatabaseMojoBridge&) = delete;
+  AdsDatabaseMojoBridge& operator=(const AdsDatabaseMojoBridge&) = delete;
+
+  void Bind(mojo::PendingReceiver<mojom::BatAdsDatabase> receiver);
+
+  // Overridden from BatAdsDatabase:
+  void RunTransaction(
+      ads::DBTransactionPtr transaction,
+      RunTransactionCallback callback) override;
+
+ private:
+  ads::Database database_;
+
+  mojo::Receiver<mojom::BatAdsDatabase> receiver_{this};
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace bat_ads
+
+#endif  // BRAVE_COMPONENTS_SERVICES_BAT_ADS_PUBLIC_CPP_ADS_DATABASE_MOJO_BRIDGE_H_
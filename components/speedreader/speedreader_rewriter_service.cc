@@ -105,6 +105,18 @@ std::unique_ptr<Rewriter> SpeedreaderRewriterService::MakeRewriter(
   return speedreader_->MakeRewriter(url.spec(), backend_);
 }
 
+std::unique_ptr<Rewriter> SpeedreaderRewriterService::MakeRewriter(
+    const GURL& url,
+    std::string* output) {
+  DCHECK(output);
+  return speedreader_->MakeRewriter(
+      url.spec(), backend_,
+      [](const char* chunk, size_t chunk_len, void* user_data) {
+        static_cast<std::string*>(user_data)->append(chunk, chunk_len);
+      },
+      output);
+}
+
 const std::string& SpeedreaderRewriterService::GetContentStylesheet() {
   return content_stylesheet_;
 }
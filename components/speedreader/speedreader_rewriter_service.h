@@ -45,6 +45,9 @@ class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
   // The API
   bool IsWhitelisted(const GURL& url);
   std::unique_ptr<Rewriter> MakeRewriter(const GURL& url);
+  // Creates a rewriter which appends its output to |output| as it is produced
+  // instead of buffering it. |output| has to outlive the rewriter.
+  std::unique_ptr<Rewriter> MakeRewriter(const GURL& url, std::string* output);
   const std::string& GetContentStylesheet();
 
  private:
@@ -5,6 +5,7 @@
 
 #include "brave/components/speedreader/speedreader_url_loader.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -24,6 +25,37 @@ namespace {
 
 constexpr uint32_t kReadBufferSize = 32768;
 
+// Upper bound for the pipe the body is sent through. Bodies up to this size
+// are copied into the pipe in one go, larger ones are written in chunks as
+// the renderer drains it.
+constexpr size_t kMaxBodyPipeCapacity = 4 * 1024 * 1024;
+
+// Runs on the thread pool. |output| starts out with the stylesheet and the
+// rewriter appends the distilled page to it. Returns |body| untouched if
+// distilling fails or doesn't find any content.
+std::string DistillPage(std::string body,
+                        std::unique_ptr<Rewriter> rewriter,
+                        std::unique_ptr<std::string> output) {
+  SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
+  const size_t stylesheet_length = output->length();
+  const int written = rewriter->Write(body.c_str(), body.length());
+  if (written == 0)
+    rewriter->End();
+  // Done with |output| before it is either returned or destroyed.
+  rewriter.reset();
+
+  // Error occurred
+  if (written != 0)
+    return body;
+
+  // TODO(brave-browser/issues/10372): would be better to pass explicit signal
+  // back from rewriter to indicate if content was found
+  if (output->length() - stylesheet_length < 1024)
+    return body;
+
+  return std::move(*output);
+}
+
 }  // namespace
 
 // static
@@ -241,34 +273,18 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
   bytes_remaining_in_buffer_ = buffered_body_.size();
 
   if (bytes_remaining_in_buffer_ > 0) {
+    // The rewriter streams its output right behind the stylesheet, so the
+    // distilled page doesn't have to be concatenated onto it afterwards.
+    auto output = std::make_unique<std::string>(
+        rewriter_service_->GetContentStylesheet());
+    auto rewriter =
+        rewriter_service_->MakeRewriter(response_url_, output.get());
+
     // Offload heavy distilling to another thread.
     base::PostTaskAndReplyWithResult(
         FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
-        base::BindOnce(
-            [](std::string data, std::unique_ptr<Rewriter> rewriter,
-               const std::string& stylesheet) -> auto {
-              SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
-              int written = rewriter->Write(data.c_str(), data.length());
-              // Error occurred
-              if (written != 0) {
-                return data;
-              }
-
-              rewriter->End();
-              const std::string& transformed = rewriter->GetOutput();
-
-              // TODO(brave-browser/issues/10372): would be better to pass
-              // explicit signal back from rewriter to indicate if content was
-              // found
-              if (transformed.length() < 1024) {
-                return data;
-              }
-
-              return stylesheet + transformed;
-            },
-            std::move(buffered_body_),
-            rewriter_service_->MakeRewriter(response_url_),
-            rewriter_service_->GetContentStylesheet()),
+        base::BindOnce(&DistillPage, std::move(buffered_body_),
+                       std::move(rewriter), std::move(output)),
         base::BindOnce(&SpeedReaderURLLoader::CompleteLoading,
                        weak_factory_.GetWeakPtr()));
     return;
@@ -289,9 +305,19 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   bytes_remaining_in_buffer_ = buffered_body_.size();
 
   throttle_->Resume();
+
+  // Size the pipe to the body where possible, so the body is copied into the
+  // pipe's shared memory once and can be released right away.
+  MojoCreateDataPipeOptions options;
+  options.struct_size = sizeof(MojoCreateDataPipeOptions);
+  options.flags = MOJO_CREATE_DATA_PIPE_FLAG_NONE;
+  options.element_num_bytes = 1;
+  options.capacity_num_bytes = static_cast<uint32_t>(
+      std::min(std::max<size_t>(bytes_remaining_in_buffer_, kReadBufferSize),
+               kMaxBodyPipeCapacity));
   mojo::ScopedDataPipeConsumerHandle body_to_send;
   MojoResult result =
-      mojo::CreateDataPipe(nullptr, body_producer_handle_, body_to_send);
+      mojo::CreateDataPipe(&options, body_producer_handle_, body_to_send);
   if (result != MOJO_RESULT_OK) {
     Abort();
     return;
@@ -355,6 +381,11 @@ void SpeedReaderURLLoader::SendReceivedBodyToClient() {
       return;
   }
   bytes_remaining_in_buffer_ -= bytes_sent;
+  if (!bytes_remaining_in_buffer_) {
+    // Everything is in the pipe now, don't keep another copy around while the
+    // destination drains it.
+    std::string().swap(buffered_body_);
+  }
   body_producer_watcher_.ArmOrNotify();
 }
 
@@ -76,6 +76,11 @@ static std::string escapify(const char* buf, int len) {
   return s.str();
 }
 
+void RunNotifications(std::vector<base::OnceClosure> notifications) {
+  for (auto& notification : notifications)
+    std::move(notification).Run();
+}
+
 }  // namespace
 
 TorControl::TorControl(base::WeakPtr<TorControl::Delegate> delegate,
@@ -87,6 +92,7 @@ TorControl::TorControl(base::WeakPtr<TorControl::Delegate> delegate,
       reading_(false),
       read_start_(-1),
       read_cr_(false),
+      batching_notifications_(false),
       delegate_(delegate) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(owner_sequence_checker_);
   DETACH_FROM_SEQUENCE(io_sequence_checker_);
@@ -94,6 +100,9 @@ TorControl::TorControl(base::WeakPtr<TorControl::Delegate> delegate,
 
 TorControl::~TorControl() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  // Deliver whatever was queued before we went away, e.g. the closed
+  // notification from Error()
+  FlushNotifications();
 }
 
 // Start()
@@ -677,13 +686,28 @@ void TorControl::ReadDoneAsync(int rv) {
 
 // ReadDone()
 //
-//      A read into readiobuf_ just completed.  Process it.  If
-//      there's no more reads to do, disable reading_.
+//      A read into readiobuf_ just completed.  Process it, and post
+//      the delegate notifications it produced to the owner sequence
+//      in a single task.
 //
 //      Caller must ensure reading_ is true and readiobuf_ is
 //      initialized.
 //
 void TorControl::ReadDone(int rv) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  DCHECK(!batching_notifications_);
+  batching_notifications_ = true;
+  ReadLines(rv);
+  batching_notifications_ = false;
+  FlushNotifications();
+}
+
+// ReadLines()
+//
+//      Process the lines of a read into readiobuf_.  If there's no
+//      more reads to do, disable reading_.
+//
+void TorControl::ReadLines(int rv) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   DCHECK(reading_);
   DCHECK(readiobuf_);
@@ -716,8 +740,9 @@ void TorControl::ReadDone(int rv) {
         // CRLF seen, so we must have i >= 2.  Emit a line and advance
         // to the next one, unless anything went wrong with the line.
         assert(i >= 1);
-        std::string line(readiobuf_->StartOfBuffer() + read_start_,
-                         readiobuf_->offset() + i - 1 - read_start_);
+        const base::StringPiece line(
+            readiobuf_->StartOfBuffer() + read_start_,
+            readiobuf_->offset() + i - 1 - read_start_);
         read_start_ = readiobuf_->offset() + i + 1;
         read_cr_ = false;
         if (!ReadLine(line)) {
@@ -773,7 +798,7 @@ void TorControl::ReadDone(int rv) {
 //      We have read a line of input; process it.  Return true on
 //      success, false on error.
 //
-bool TorControl::ReadLine(const std::string& line) {
+bool TorControl::ReadLine(base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
 
   if (line.size() < 4) {
@@ -788,9 +813,9 @@ bool TorControl::ReadLine(const std::string& line) {
   // intermediate reply and ` ' for a final reply.
   //
   // TODO(riastradh): parse or check syntax of status
-  std::string status(line, 0, 3);
+  const base::StringPiece status = line.substr(0, 3);
   char pos = line[3];
-  std::string reply(line, 4);
+  const base::StringPiece reply = line.substr(4);
 
   // Determine whether it is an asynchronous reply, status 6yz.
   if (status[0] == '6') {
@@ -801,8 +826,8 @@ bool TorControl::ReadLine(const std::string& line) {
     if (!async_) {
       // Parse the keyword and the initial line.
       const size_t sp = reply.find(' ');
-      std::string event_name, initial;
-      if (sp == std::string::npos) {
+      base::StringPiece event_name, initial;
+      if (sp == base::StringPiece::npos) {
         event_name = reply;
       } else {
         event_name = reply.substr(0, sp);
@@ -815,7 +840,8 @@ bool TorControl::ReadLine(const std::string& line) {
           // Single-line async reply.
 
           // Bail if we don't recognize the event name.
-          const auto& found = kTorControlEventByName.find(event_name);
+          const auto& found =
+              kTorControlEventByName.find(event_name.as_string());
           if (found == kTorControlEventByName.end()) {
             VLOG(1) << "tor: unknown event: " << event_name;  // XXX escape
             return false;
@@ -830,7 +856,7 @@ bool TorControl::ReadLine(const std::string& line) {
 
           // Notify the delegate of the parsed reply.  No extra
           // because there were no intermediate reply lines.
-          NotifyTorEvent(event, initial, {});
+          NotifyTorEvent(event, initial.as_string(), {});
 
           return true;
         }
@@ -839,13 +865,14 @@ bool TorControl::ReadLine(const std::string& line) {
 
           // Start a fresh async reply state.  Parse the rest, but
           // skip it, if we don't recognize the event.
-          const auto& found = kTorControlEventByName.find(event_name);
+          const auto& found =
+              kTorControlEventByName.find(event_name.as_string());
           const TorControlEvent event =
               (found == kTorControlEventByName.end() ? TorControlEvent::INVALID
                                                      : (*found).second);
           async_ = std::make_unique<Async>();
           async_->event = event;
-          async_->initial = initial;
+          async_->initial = initial.as_string();
           async_->skip = (event == TorControlEvent::INVALID);
           return true;
         }
@@ -901,7 +928,8 @@ bool TorControl::ReadLine(const std::string& line) {
             // If we're still subscribed, notify the delegate of the
             // parsed reply.
             if (async_events_.count(async_->event)) {
-              NotifyTorEvent(async_->event, async_->initial, async_->extra);
+              NotifyTorEvent(async_->event, std::move(async_->initial),
+                             std::move(async_->extra));
             }
           }
           async_.reset();
@@ -916,8 +944,11 @@ bool TorControl::ReadLine(const std::string& line) {
       case '-':
         NotifyTorRawMid(status, reply);
         if (!cmdq_.empty()) {
+          // Command callbacks post to the owner sequence on their own,
+          // so deliver what was read before this line ahead of them.
+          FlushNotifications();
           PerLineCallback& perline = cmdq_.front().first;
-          perline.Run(status, reply);
+          perline.Run(status.as_string(), reply.as_string());
         }
         return true;
       case '+':
@@ -927,9 +958,11 @@ bool TorControl::ReadLine(const std::string& line) {
       case ' ':
         NotifyTorRawEnd(status, reply);
         if (!cmdq_.empty()) {
+          FlushNotifications();
           CmdCallback& callback = cmdq_.front().second;
           bool error = false;
-          std::move(callback).Run(error, status, reply);
+          std::move(callback).Run(error, status.as_string(),
+                                  reply.as_string());
           cmdq_.pop();
         }
         return true;
@@ -956,6 +989,7 @@ void TorControl::Error() {
   VLOG(1) << "tor: closing control on " << (running_ ? "request" : "error");
 
   NotifyTorControlClosed();
+  FlushNotifications();
 
   // Invoke all callbacks with errors and clear read state.
   while (!cmdq_.empty()) {
@@ -980,55 +1014,73 @@ void TorControl::Error() {
 
 void TorControl::NotifyTorControlReady() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  owner_task_runner_->PostTask(
-      FROM_HERE, base::BindOnce(&Delegate::OnTorControlReady, delegate_));
+  QueueNotification(base::BindOnce(&Delegate::OnTorControlReady, delegate_));
 }
 
 void TorControl::NotifyTorControlClosed() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  owner_task_runner_->PostTask(
-      FROM_HERE,
+  QueueNotification(
       base::BindOnce(&Delegate::OnTorControlClosed, delegate_, running_));
 }
 
-void TorControl::NotifyTorEvent(
-    TorControlEvent event,
-    const std::string& initial,
-    const std::map<std::string, std::string>& extra) {
+void TorControl::NotifyTorEvent(TorControlEvent event,
+                                std::string initial,
+                                std::map<std::string, std::string> extra) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  owner_task_runner_->PostTask(
-      FROM_HERE,
-      base::BindOnce(&Delegate::OnTorEvent, delegate_, event, initial, extra));
+  QueueNotification(base::BindOnce(&Delegate::OnTorEvent, delegate_, event,
+                                   std::move(initial), std::move(extra)));
 }
 
-void TorControl::NotifyTorRawCmd(const std::string& cmd) {
+void TorControl::NotifyTorRawCmd(base::StringPiece cmd) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  owner_task_runner_->PostTask(
-      FROM_HERE, base::BindOnce(&Delegate::OnTorRawCmd, delegate_, cmd));
+  QueueNotification(
+      base::BindOnce(&Delegate::OnTorRawCmd, delegate_, cmd.as_string()));
 }
 
-void TorControl::NotifyTorRawAsync(const std::string& status,
-                                   const std::string& line) {
+void TorControl::NotifyTorRawAsync(base::StringPiece status,
+                                   base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  owner_task_runner_->PostTask(
-      FROM_HERE,
-      base::BindOnce(&Delegate::OnTorRawAsync, delegate_, status, line));
+  QueueNotification(base::BindOnce(&Delegate::OnTorRawAsync, delegate_,
+                                   status.as_string(), line.as_string()));
 }
 
-void TorControl::NotifyTorRawMid(const std::string& status,
-                                 const std::string& line) {
+void TorControl::NotifyTorRawMid(base::StringPiece status,
+                                 base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  owner_task_runner_->PostTask(
-      FROM_HERE,
-      base::BindOnce(&Delegate::OnTorRawMid, delegate_, status, line));
+  QueueNotification(base::BindOnce(&Delegate::OnTorRawMid, delegate_,
+                                   status.as_string(), line.as_string()));
+}
+
+void TorControl::NotifyTorRawEnd(base::StringPiece status,
+                                 base::StringPiece line) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  QueueNotification(base::BindOnce(&Delegate::OnTorRawEnd, delegate_,
+                                   status.as_string(), line.as_string()));
 }
 
-void TorControl::NotifyTorRawEnd(const std::string& status,
-                                 const std::string& line) {
+// QueueNotification(notification)
+//
+//      Queue a delegate notification.  While ReadDone() processes a
+//      read, notifications are held until it is done or a command
+//      callback runs, so all the lines of one read reach the owner
+//      sequence in a single task and in order with command replies.
+//      Otherwise the notification is posted right away.
+//
+void TorControl::QueueNotification(base::OnceClosure notification) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  pending_notifications_.push_back(std::move(notification));
+  if (!batching_notifications_)
+    FlushNotifications();
+}
+
+void TorControl::FlushNotifications() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
+  if (pending_notifications_.empty())
+    return;
+  std::vector<base::OnceClosure> notifications;
+  notifications.swap(pending_notifications_);
   owner_task_runner_->PostTask(
-      FROM_HERE,
-      base::BindOnce(&Delegate::OnTorRawEnd, delegate_, status, line));
+      FROM_HERE, base::BindOnce(&RunNotifications, std::move(notifications)));
 }
 
 // ParseKV(string, key, value)
@@ -1038,7 +1090,7 @@ void TorControl::NotifyTorRawEnd(const std::string& status,
 //      success, false on failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(base::StringPiece string,
                          std::string* key,
                          std::string* value) {
   size_t end;
@@ -1053,20 +1105,20 @@ bool TorControl::ParseKV(const std::string& string,
 //      failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(base::StringPiece string,
                          std::string* key,
                          std::string* value,
                          size_t* end) {
   DCHECK(key && value && end);
   // Search for `=' -- it had better be there.
-  size_t eq = string.find("=");
-  if (eq == std::string::npos)
+  size_t eq = string.find('=');
+  if (eq == base::StringPiece::npos)
     return false;
   size_t vstart = eq + 1;
 
   // If we're at the end of the string, value is empt.
   if (vstart == string.size()) {
-    *key = string.substr(0, eq);
+    *key = string.substr(0, eq).as_string();
     *value = "";
     *end = string.size();
     return true;
@@ -1076,7 +1128,7 @@ bool TorControl::ParseKV(const std::string& string,
   if (string[vstart] != '"') {
     // Not quoted.  Check for a delimiter.
     size_t i, vend = string.size();
-    if ((i = string.find(" ", vstart)) != std::string::npos) {
+    if ((i = string.find(' ', vstart)) != base::StringPiece::npos) {
       // Delimited.  Stop at the delimiter, and consume it.
       vend = i;
       *end = vend + 1;
@@ -1086,19 +1138,19 @@ bool TorControl::ParseKV(const std::string& string,
     }
 
     // Check for internal quotes; they are forbidden.
-    if ((i = string.find("\"", vstart)) != std::string::npos)
+    if ((i = string.find('"', vstart)) != base::StringPiece::npos)
       return false;
 
     // Extract the key and value and we're done.
-    *key = string.substr(0, eq);
-    *value = string.substr(vstart, vend - vstart);
+    *key = string.substr(0, eq).as_string();
+    *value = string.substr(vstart, vend - vstart).as_string();
     return true;
   }
 
   // Quoted string.  Parse it, and consume trailing spaces.
   if (!ParseQuoted(string.substr(eq + 1), value, end))
     return false;
-  *key = string.substr(0, eq);
+  *key = string.substr(0, eq).as_string();
   *end += eq + 1;
   while (*end < string.size() && string[*end] == ' ')
     (*end)++;
@@ -1113,7 +1165,7 @@ bool TorControl::ParseKV(const std::string& string,
 //      return false on failure.
 //
 // static
-bool TorControl::ParseQuoted(const std::string& string,
+bool TorControl::ParseQuoted(base::StringPiece string,
                              std::string* value,
                              size_t* end) {
   enum {
@@ -18,6 +18,7 @@
 #include "base/callback.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/strings/string_piece.h"
 
 namespace base {
 class SequencedTaskRunner;
@@ -98,16 +99,18 @@ class TorControl {
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ParseQuoted);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ParseKV);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ReadLine);
+  FRIEND_TEST_ALL_PREFIXES(TorControlTest, ReadLineTranscript);
+  FRIEND_TEST_ALL_PREFIXES(TorControlTest, NotificationsPrecedeLaterReplies);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, GetCircuitEstablishedDone);
 
-  static bool ParseKV(const std::string& string,
+  static bool ParseKV(base::StringPiece string,
                       std::string* key,
                       std::string* value);
-  static bool ParseKV(const std::string& string,
+  static bool ParseKV(base::StringPiece string,
                       std::string* key,
                       std::string* value,
                       size_t* end);
-  static bool ParseQuoted(const std::string& string,
+  static bool ParseQuoted(base::StringPiece string,
                           std::string* value,
                           size_t* end);
 
@@ -171,12 +174,18 @@ class TorControl {
   void NotifyTorControlClosed();
 
   void NotifyTorEvent(TorControlEvent,
-                      const std::string& initial,
-                      const std::map<std::string, std::string>& extra);
-  void NotifyTorRawCmd(const std::string& cmd);
-  void NotifyTorRawAsync(const std::string& status, const std::string& line);
-  void NotifyTorRawMid(const std::string& status, const std::string& line);
-  void NotifyTorRawEnd(const std::string& status, const std::string& line);
+                      std::string initial,
+                      std::map<std::string, std::string> extra);
+  void NotifyTorRawCmd(base::StringPiece cmd);
+  void NotifyTorRawAsync(base::StringPiece status, base::StringPiece line);
+  void NotifyTorRawMid(base::StringPiece status, base::StringPiece line);
+  void NotifyTorRawEnd(base::StringPiece status, base::StringPiece line);
+
+  // Delegate notifications produced while reading are batched, so that a
+  // burst of control lines costs a single task on the owner sequence instead
+  // of one per line
+  void QueueNotification(base::OnceClosure notification);
+  void FlushNotifications();
 
   void StartWrite();
   void DoWrites();
@@ -187,7 +196,9 @@ class TorControl {
   void DoReads();
   void ReadDoneAsync(int rv);
   void ReadDone(int rv);
-  bool ReadLine(const std::string& line);
+  void ReadLines(int rv);
+  // |line| points into |readiobuf_| and is only valid during the call
+  bool ReadLine(base::StringPiece line);
 
   void Error();
 
@@ -227,6 +238,11 @@ class TorControl {
   };
   std::unique_ptr<Async> async_;
 
+  // Delegate notifications waiting for the next flush, in order
+  std::vector<base::OnceClosure> pending_notifications_;
+  // True while ReadDone() processes a read, which flushes once at the end
+  bool batching_notifications_;
+
   base::WeakPtr<TorControl::Delegate> delegate_;
 
   base::WeakPtrFactory<TorControl> weak_ptr_factory_{this};
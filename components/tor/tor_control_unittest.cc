@@ -5,8 +5,10 @@
 
 #include "brave/components/tor/tor_control.h"
 
+#include "base/bind_post_task.h"
 #include "base/callback_helpers.h"
 #include "base/run_loop.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_task_environment.h"
@@ -184,6 +186,117 @@ TEST(TorControlTest, ReadLine) {
   base::RunLoop().RunUntilIdle();
 }
 
+TEST(TorControlTest, ReadLineTranscript) {
+  content::BrowserTaskEnvironment task_environment;
+  scoped_refptr<base::SequencedTaskRunner> io_task_runner =
+      content::GetIOThreadTaskRunner({});
+
+  MockTorControlDelegate delegate;
+  std::unique_ptr<TorControl> control =
+      std::make_unique<TorControl>(delegate.AsWeakPtr(), io_task_runner);
+
+  // Events from a busy control port, delivered in the order they were read
+  EXPECT_CALL(delegate, OnTorRawAsync(testing::_, testing::_))
+      .Times(testing::AnyNumber());
+  {
+    testing::InSequence sequence;
+    EXPECT_CALL(delegate, OnTorEvent(TorControlEvent::STATUS_CLIENT,
+                                     "NOTICE CIRCUIT_ESTABLISHED", testing::_))
+        .Times(1);
+    std::map<std::string, std::string> stream_extra = {{"PURPOSE", "USER"}};
+    EXPECT_CALL(delegate,
+                OnTorEvent(TorControlEvent::STREAM,
+                           "42 NEW 0 www.brave.com:443 SOURCE_ADDR="
+                           "127.0.0.1:51234",
+                           stream_extra))
+        .Times(1);
+    EXPECT_CALL(delegate, OnTorEvent(TorControlEvent::STREAM,
+                                     "42 SUCCEEDED 7 1.2.3.4:443", testing::_))
+        .Times(1);
+    EXPECT_CALL(delegate, OnTorEvent(TorControlEvent::STREAM,
+                                     "42 CLOSED 7 1.2.3.4:443", testing::_))
+        .Times(1);
+  }
+  EXPECT_CALL(delegate, OnTorControlClosed(false)).Times(0);
+
+  io_task_runner->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          [](std::unique_ptr<TorControl> control) {
+            control->async_events_[TorControlEvent::STATUS_CLIENT] = 1;
+            control->async_events_[TorControlEvent::STREAM] = 1;
+            const char* transcript[] = {
+                "650 STATUS_CLIENT NOTICE CIRCUIT_ESTABLISHED",
+                "650 CIRC 7 BUILT $AAAA~relay PURPOSE=GENERAL",
+                "650-STREAM 42 NEW 0 www.brave.com:443 "
+                "SOURCE_ADDR=127.0.0.1:51234",
+                "650 PURPOSE=USER",
+                "650 STREAM 42 SUCCEEDED 7 1.2.3.4:443",
+                "650 STREAM_BW 42 512 1024",
+                "650 STREAM 42 CLOSED 7 1.2.3.4:443",
+            };
+            for (const char* line : transcript)
+              EXPECT_TRUE(control->ReadLine(line)) << line;
+          },
+          std::move(control)));
+
+  base::RunLoop().RunUntilIdle();
+}
+
+TEST(TorControlTest, NotificationsPrecedeLaterReplies) {
+  content::BrowserTaskEnvironment task_environment;
+  scoped_refptr<base::SequencedTaskRunner> io_task_runner =
+      content::GetIOThreadTaskRunner({});
+
+  MockTorControlDelegate delegate;
+  std::unique_ptr<TorControl> control =
+      std::make_unique<TorControl>(delegate.AsWeakPtr(), io_task_runner);
+
+  // The reply was read after the event, so it must not be overtaken by it
+  testing::MockFunction<void(const std::string&)> reply;
+  EXPECT_CALL(delegate, OnTorRawAsync(testing::_, testing::_))
+      .Times(testing::AnyNumber());
+  EXPECT_CALL(delegate, OnTorRawEnd(testing::_, testing::_))
+      .Times(testing::AnyNumber());
+  {
+    testing::InSequence sequence;
+    EXPECT_CALL(delegate, OnTorEvent(TorControlEvent::STATUS_CLIENT,
+                                     "NOTICE CIRCUIT_NOT_ESTABLISHED",
+                                     testing::_))
+        .Times(1);
+    EXPECT_CALL(reply, Call("250")).Times(1);
+  }
+
+  auto reply_callback = base::BindPostTask(
+      base::SequencedTaskRunnerHandle::Get(),
+      base::BindOnce(
+          [](testing::MockFunction<void(const std::string&)>* reply,
+             bool error, const std::string& status, const std::string&) {
+            reply->Call(status);
+          },
+          &reply));
+
+  io_task_runner->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          [](std::unique_ptr<TorControl> control,
+             TorControl::CmdCallback reply_callback) {
+            control->async_events_[TorControlEvent::STATUS_CLIENT] = 1;
+            control->cmdq_.push(std::make_pair(base::DoNothing(),
+                                               std::move(reply_callback)));
+            // Emulate a single read
+            control->batching_notifications_ = true;
+            EXPECT_TRUE(control->ReadLine(
+                "650 STATUS_CLIENT NOTICE CIRCUIT_NOT_ESTABLISHED"));
+            EXPECT_TRUE(control->ReadLine("250 OK"));
+            control->batching_notifications_ = false;
+            control->FlushNotifications();
+          },
+          std::move(control), std::move(reply_callback)));
+
+  base::RunLoop().RunUntilIdle();
+}
+
 TEST(TorControlTest, GetCircuitEstablishedDone) {
   content::BrowserTaskEnvironment task_environment;
   scoped_refptr<base::SequencedTaskRunner> io_task_runner =